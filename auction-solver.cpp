@@ -3,68 +3,228 @@
 #include "auction-solver.h"
 
 int main(int argc, char *argv[]) {
+    // Lift a solution of an exported kernel back into a full auction result
+    if (argc >= 2 && std::string(argv[1]) == "lift") {
+        if (argc < 5) {
+            std::cerr << "Missing argument(s)." << std::endl;
+            std::cout << "Usage: ./auction-solver lift [auction file name] [kernel prefix] [kernel solution file]" << std::endl;
+            return 1;
+        }
+
+        if (readAuctionMwvc(argv[2]) != 0) {
+            std::cerr << "Error reading from auction file." << std::endl;
+            return 1;
+        }
+
+        if (liftKernelSolution(argv[3], argv[4]) != 0) {
+            std::cerr << "Error lifting kernel solution." << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
     // Input auction file name missing
     if (argc < 3) {
         std::cerr << "Missing argument(s)." << std::endl;
-        std::cout << "Usage: ./auction-solver [auction file name]" << std::endl;
+        std::cout << "Usage: ./auction-solver [auction file name] [kernalization flag] [--export-kernel prefix] [--kernel-cache dir] [--rc-fix] [--warm-start results] [--threads N] [--construct-threads N] [--construct-time-ms T] [--multilevel] [--partitioned] [--stream] [--gap G] [--time-ms T] [--max-steps N] [--stall-steps N] [--checkpoint file] [--checkpoint-interval S] [--resume]" << std::endl;
         return 1;
     }
 
     // Read in name of input auction file
     std::string auctionFileName = argv[1];
 
+    // Read in options
+    std::string kernelPrefix;
+    std::string cacheDir;
+    std::string warmStartFile;
+    bool reducedCostFixing = false;
+    FastwvcOptions fastwvcOptions;
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+
+        if (option == "--export-kernel" && i + 1 < argc) {
+            kernelPrefix = argv[++i];
+        } else if (option == "--kernel-cache" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (option == "--warm-start" && i + 1 < argc) {
+            warmStartFile = argv[++i];
+        } else if (option == "--rc-fix") {
+            reducedCostFixing = true;
+        } else if (option == "--threads" && i + 1 < argc) {
+            fastwvcOptions.threads = std::stoi(argv[++i]);
+        } else if (option == "--construct-threads" && i + 1 < argc) {
+            fastwvcOptions.constructThreads = std::stoi(argv[++i]);
+        } else if (option == "--construct-time-ms" && i + 1 < argc) {
+            fastwvcOptions.constructTime = std::stod(argv[++i]) / 1000.0;
+        } else if (option == "--multilevel") {
+            fastwvcOptions.multilevel = true;
+        } else if (option == "--checkpoint" && i + 1 < argc) {
+            fastwvcOptions.checkpointFile = argv[++i];
+        } else if (option == "--checkpoint-interval" && i + 1 < argc) {
+            fastwvcOptions.checkpointInterval = std::stod(argv[++i]);
+        } else if (option == "--resume") {
+            fastwvcOptions.resume = true;
+        } else if (option == "--partitioned") {
+            fastwvcOptions.partitioned = true;
+        } else if (option == "--time-ms" && i + 1 < argc) {
+            fastwvcOptions.timeLimit = std::stod(argv[++i]) / 1000.0;
+        } else if (option == "--max-steps" && i + 1 < argc) {
+            fastwvcOptions.maxSteps = std::stoll(argv[++i]);
+        } else if (option == "--stall-steps" && i + 1 < argc) {
+            fastwvcOptions.stallSteps = std::stoll(argv[++i]);
+        } else if (option == "--gap" && i + 1 < argc) {
+            fastwvcOptions.targetGap = std::stod(argv[++i]);
+        } else if (option == "--stream") {
+            // Report every improvement of the MWVC search as it is found
+            fastwvcOptions.onImprovement = [](long long mwvcValue, double time, long long step) {
+                std::cout << "MWVC VALUE: " << mwvcValue << " (" << time << "s, step " << step << ")" << std::endl;
+            };
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+
     // Read all auction information from input file
-    if (readAuction(auctionFileName) != 0) {
+    if (readAuctionMwvc(auctionFileName) != 0) {
         std::cerr << "Error reading from auction file." << std::endl;
         return 1;
     }
 
-    // Build the conflict graph
-    buildConflictGraph();
+    // Reuse the kernel partition of a previous run on the same auction
+    std::string cacheKey;
+    bool kernelCached = false;
+    if (argv[2][0] != '0' && !cacheDir.empty()) {
+        cacheKey = auctionContentHash();
+        kernelCached = loadKernelCache(cacheDir, cacheKey) == 0;
+    }
 
-    // Kernalize
-    if (argv[2][0] != '0') {
-        int kernalizationOutput = kernalize();
+    if (!kernelCached) {
+        // Fix simplicial bids before the conflict graph is built
+        if (argv[2][0] != '0') {
+            simplicialReduce();
+        }
+
+        // Build the conflict graph
+        buildConflictGraph();
+
+        // Kernalize
+        if (argv[2][0] != '0' && numBids > 0) {
+            int kernalizationOutput = kernalize();
+
+            // Kernalization error
+            if (kernalizationOutput == -1) {
+                return 1;
+            }
+        }
 
-        // Kernalization error
-        if (kernalizationOutput == -1) {
+        // Store the kernel partition for later runs
+        if (!cacheKey.empty() && storeKernelCache(cacheDir, cacheKey) != 0) {
+            std::cerr << "Error writing kernel cache." << std::endl;
+        }
+    }
+
+    // Fix provably losing (and winning) bids against the incumbent of a
+    // short FastWVC run on the kernel (a greedy auction if it finds no cover),
+    // taking its time and steps out of the search budget
+    std::unordered_set<int> incumbentOriginalIds;
+    bool incumbentFound = false;
+    if (reducedCostFixing && numBids > 0) {
+        FastwvcOptions incumbentOptions;
+        incumbentOptions.threads = fastwvcOptions.threads;
+        incumbentOptions.constructThreads = fastwvcOptions.constructThreads;
+        incumbentOptions.timeLimit = fastwvcOptions.timeLimit / 10;
+        incumbentOptions.maxSteps = fastwvcOptions.maxSteps / 10;
+        fastwvcOptions.timeLimit -= incumbentOptions.timeLimit;
+        fastwvcOptions.maxSteps -= incumbentOptions.maxSteps;
+
+        std::vector<int> incumbentCover;
+        std::vector<int> incumbentMwvcBids;
+        if (argv[2][0] != '0') {
+            incumbentCover = buildLpGuidedCover();
+        }
+        long long incumbentMwvcValue = fastwvcSolve(incumbentOptions, incumbentCover, incumbentMwvcBids);
+        long long incumbentValue = incumbentMwvcValue != -1 ? totalValue - incumbentMwvcValue : greedyAuctionValue();
+
+        // Bid IDs change with the fixing, original IDs do not
+        incumbentFound = incumbentMwvcValue != -1;
+        for (int bidId : incumbentMwvcBids) {
+            incumbentOriginalIds.insert(bids[bidId - 1].originalBidId);
+        }
+
+        if (reducedCostFix(incumbentValue) == -1) {
             return 1;
         }
+    }
+
+    // Export the kernel as a standalone instance
+    if (!kernelPrefix.empty() && writeKernelInstance(kernelPrefix) != 0) {
+        std::cerr << "Error exporting kernel instance." << std::endl;
+        return 1;
+    }
+
+    // Reductions have "solved" the problem
+    std::vector<int> mwvcBids;
+    if (numBids == 0) {
+        outputOptimalAuction(0, mwvcBids);
+        return 0;
+    }
+
+    // Start the search on a kernalized instance from its LP-guided cover
+    // and stop it once the kernel LP bound is reached
+    std::vector<int> initialCover;
+    if (argv[2][0] != '0') {
+        if (kernelEdgeDuals.empty() && !edges.empty()) {
+            std::cerr << "No kernel LP duals: searching without the LP-guided cover and lower bound." << std::endl;
+        }
+        initialCover = buildLpGuidedCover();
+        fastwvcOptions.lowerBound = mwvcLowerBound();
+    }
 
-        // Kernalization has "solved" the problem
-        else if (kernalizationOutput == 0) {
-            outputOptimalAuction("", "");
-            return 0;
+    // Or from the reduced-cost incumbent, which satisfies every fixing
+    // and so stays a cover of the remaining bids
+    std::vector<int> incumbentMwvcBids;
+    long long incumbentMwvcValue = 0;
+    if (incumbentFound) {
+        for (Bid& bid : bids) {
+            if (incumbentOriginalIds.count(bid.originalBidId) > 0) {
+                incumbentMwvcBids.push_back(bid.bidId);
+                incumbentMwvcValue += bid.value;
+            }
         }
+        initialCover = incumbentMwvcBids;
     }
 
-    // Write conflict graph to mwvc file
-    if (writeGraphToMwvcFile() != 0) {
-        std::cerr << "Error writing conflict graph to mwvc file." << std::endl;
+    // Or from the winners of a previous run on a similar auction
+    if (!warmStartFile.empty() && buildWarmStartCover(warmStartFile, initialCover) != 0) {
+        std::cerr << "Error reading warm start results file." << std::endl;
         return 1;
     }
 
-    // Compile and run fastmwvc solver on conflict graph
-    const char *compileFastwvcCommand = 
-        "g++ fastwvc/mwvc.cpp -O3 --std=c++11 -o mwvc";
-    system(compileFastwvcCommand);
+    // Run fastwvc solver on conflict graph
+    long long mwvcValue = fastwvcSolve(fastwvcOptions, initialCover, mwvcBids);
 
-    // Run fastwvc and create a streambuf that reads its stdout and stderr
-    const char *runFastwvcCommand = "./mwvc auction.mwvc 0 1 0";
-    redi::ipstream proc(runFastwvcCommand, redi::pstreams::pstdout);
+    // A multilevel or partitioned start may lose the incumbent's cover
+    if (incumbentFound && (mwvcValue == -1 || mwvcValue > incumbentMwvcValue)) {
+        mwvcValue = incumbentMwvcValue;
+        mwvcBids = incumbentMwvcBids;
+    }
 
-    // Read fastwvc's stdout
-    std::string fastwvcOutputLine1;
-    std::string fastwvcOutputLine2;
-    std::getline(proc.out(), fastwvcOutputLine1);
-    std::getline(proc.out(), fastwvcOutputLine2);
+    if (mwvcValue == -1) {
+        std::cerr << "FastWVC found no valid cover." << std::endl;
+        return 1;
+    }
 
     // Output fastwvc output
-    std::cout << fastwvcOutputLine1 << std::endl;
-    std::cout << fastwvcOutputLine2 << std::endl;
+    std::cout << "MWVC VALUE: " << mwvcValue << std::endl;
+    if (fastwvcOptions.lowerBound > 0) {
+        std::cout << "MWVC LOWER BOUND: " << fastwvcOptions.lowerBound << std::endl;
+        std::cout << "MWVC GAP: " << FastWVC::GapOf(mwvcValue, fastwvcOptions.lowerBound) << std::endl;
+    }
 
     // Output optimal auction results
-    if (outputOptimalAuction(fastwvcOutputLine1, fastwvcOutputLine2) != 0) {
+    if (outputOptimalAuction(mwvcValue, mwvcBids) != 0) {
         std::cerr << "Error writing optimal auction results to file." << std::endl;
         return 1;
     }
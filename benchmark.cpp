@@ -64,7 +64,8 @@ int main(int argc, char *argv[]) {
             auto duration = end - start;
             auto ms = duration * 0.001;
             std::cout << "FastWVC - solved via kernalization (ms): " << ms << std::endl;
-            outputOptimalAuction("", "");
+            std::vector<int> mwvcBids;
+            outputOptimalAuction(0, mwvcBids);
             solvedByKernelization = true;
         }
     } else {
@@ -73,25 +74,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (!solvedByKernelization) {
-        // Write conflict graph to mwvc file
-        if (writeGraphToMwvcFile() != 0) {
-            std::cerr << "Error writing conflict graph to mwvc file." << std::endl;
-            return 1;
-        }
-
-        // Compile and run fastmwvc solver on conflict graph
-        const char *compileFastWvc = "g++ fastwvc/mwvc.cpp -O3 --std=c++11 -o mwvc";
-        system(compileFastWvc);
-
-        // Run fastwvc and create a streambuf that reads its stdout and stderr
-        const char *runFastWvc = "./mwvc auction.mwvc 0 1 0";
-        redi::ipstream proc(runFastWvc, redi::pstreams::pstdout);
-
-        // Read fastwvc's stdout
-        std::string fastwvcOutputLine1;
-        std::string fastwvcOutputLine2;
-        std::getline(proc.out(), fastwvcOutputLine1);
-        std::getline(proc.out(), fastwvcOutputLine2);
+        // Run fastwvc solver on conflict graph
+        FastwvcOptions fastwvcOptions;
+        std::vector<int> initialCover;
+        std::vector<int> mwvcBids;
+        long long mwvcValue = fastwvcSolve(fastwvcOptions, initialCover, mwvcBids);
 
         endTime = std::chrono::high_resolution_clock::now();
         auto start = std::chrono::time_point_cast<std::chrono::microseconds>(startTime).time_since_epoch().count();
@@ -101,10 +88,8 @@ int main(int argc, char *argv[]) {
         std::cout << "FastWVC (ms): " << ms << std::endl;
 
         // Output optimal auction results
-        if (outputOptimalAuction(fastwvcOutputLine1, fastwvcOutputLine2) != 0) {
+        if (mwvcValue == -1 || outputOptimalAuction(mwvcValue, mwvcBids) != 0) {
             std::cerr << "Error writing optimal auction results to file." << std::endl;
-            std::cerr << fastwvcOutputLine1 << std::endl;
-            std::cerr << fastwvcOutputLine2 << std::endl;
         }
     }
 
@@ -1,18 +1,25 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
-#include "pstreams-1.0.3/pstream.h"
+#include <sys/stat.h>
+#include "fastwvc/mwvc.h"
+#include "fastwvc/multilevel.h"
+#include "fastwvc/partition.h"
 
 #include "gurobi_c++.h"
 
 struct Bid {
     std::vector<int> bidGoods;
     int bidId;
+    int originalBidId;
     int value;
 };
 
@@ -21,6 +28,34 @@ struct Edge {
     int v2;
 };
 
+struct FastwvcOptions {
+    int threads = 1;
+    // Threads for the randomized initial constructions (0 for all cores)
+    int constructThreads = 1;
+    // Seconds for those constructions (0 for a tenth of the time limit)
+    double constructTime = 0.0;
+    // Spend half of the time on a multilevel solve and start from its cover
+    bool multilevel = false;
+    // Spend half of the time on a partition-parallel search (one region per
+    // thread) and start from its cover
+    bool partitioned = false;
+    // Search budgets: wall-clock seconds, total steps and steps without
+    // improvement (0 for no step budget)
+    double timeLimit = 1.0;
+    long long maxSteps = 0;
+    long long stallSteps = 0;
+    // Called with the MWVC value, time (seconds) and step of every new best cover
+    ImprovementCallback onImprovement;
+    // Stop once (cover weight - lowerBound) <= targetGap * cover weight
+    long long lowerBound = 0;
+    double targetGap = 0.0;
+    // Save the search state to checkpointFile every checkpointInterval
+    // seconds and at the end; with resume, continue from it if it matches
+    std::string checkpointFile;
+    double checkpointInterval = 60.0;
+    bool resume = false;
+};
+
 int                     numGoods;
 int                     numBids;
 int                     numPruned0;
@@ -30,8 +65,10 @@ long long               excludedBidsValues = 0;
 long long               includedBidsValues = 0;
 std::vector<Bid>        bids;
 std::vector<Bid>        bidsExcludedFromMwvcByKernalization;
+std::vector<Bid>        bidsIncludedInMwvcByKernalization;
 std::vector<Edge>       edges;
 std::unordered_map<int, std::vector<int>>   bidsContainingGood;
+std::unordered_map<long long, double>       kernelEdgeDuals;
 
 // General solver functions
 void resetState();
@@ -40,15 +77,39 @@ std::string convertToDzn(std::string fileName);
 int readAuctionMwvc(std::string auctionFileName);
 int readCatsAuctionMwvc(std::string auctionFileName);
 int readCatsAuctionSetPacking(std::string auctionFileName);
+void buildGoodsIndex();
 void buildConflictGraph();
-int writeGraphToMwvcFile();
-int outputOptimalAuction(std::string mwvcOutLine1, std::string mwvcOutLine2);
+int writeGraphToMwvcFile(std::string mwvcFileName = "auction.mwvc");
+int outputOptimalAuction(long long mwvcValue, std::vector<int>& mwvcBids);
+int outputAuctionWinners(std::vector<Bid>& winningBids);
+long long fastwvcSolve(FastwvcOptions& options, std::vector<int>& initialCover, std::vector<int>& mwvcBids);
 long long gurobiMwvcSolve();
 long long gurobiSetPackingSolve();
+void buildSetPackingModel(GRBModel& model, std::vector<GRBVar>& bidVars, char varType);
 
 // Kernalization logic
+int simplicialReduce();
 int kernalize();
+void pruneBids(std::vector<int>& mwvcValues, bool rebuildEdges);
+void reassignBidIds(std::vector<Bid>& remainingBids);
 void refactorConflictGraph(std::vector<Bid>& remainingBids);
+long long greedyAuctionValue();
+int reducedCostFix(long long incumbentValue);
+long long originalEdgeKey(Bid& bid1, Bid& bid2);
+std::vector<int> buildLpGuidedCover();
+long long mwvcLowerBound();
+int buildWarmStartCover(std::string resultsFileName, std::vector<int>& initialCover);
+
+// Kernel export and lifting
+int writeKernelInstance(std::string kernelPrefix);
+int writeGraphToBinaryFile(std::string binaryFileName);
+int writeKernelLiftingMap(std::string liftFileName);
+int liftKernelSolution(std::string kernelPrefix, std::string solutionFileName);
+
+// Kernalization cache
+std::string auctionContentHash();
+int loadKernelCache(std::string cacheDir, std::string cacheKey);
+int storeKernelCache(std::string cacheDir, std::string cacheKey);
 
 /*
  * Resets auction state
@@ -64,8 +125,10 @@ void resetState() {
 
     bids.clear();
     bidsExcludedFromMwvcByKernalization.clear();
+    bidsIncludedInMwvcByKernalization.clear();
     edges.clear();
     bidsContainingGood.clear();
+    kernelEdgeDuals.clear();
 }
 
 /*
@@ -245,6 +308,7 @@ int readAuctionMwvc(std::string auctionFileName) {
             
             Bid newBid = {};
             newBid.bidId = bidNum;
+            newBid.originalBidId = bidNum;
 
             // Read bid value
             int readValue;
@@ -315,6 +379,7 @@ int readCatsAuctionMwvc(std::string auctionFileName) {
             int bidValue;
             std::string bidGood;
             newBid.bidId = bidNum;
+            newBid.originalBidId = bidNum;
 
             // Read bid line
             std::getline(infile, line);
@@ -391,6 +456,7 @@ int readCatsAuctionSetPacking(std::string auctionFileName) {
             int bidValue;
             std::string bidGood;
             newBid.bidId = bidNum;
+            newBid.originalBidId = bidNum;
 
             // Read bid line
             std::getline(infile, line);
@@ -429,13 +495,27 @@ int readCatsAuctionSetPacking(std::string auctionFileName) {
     return 1;
 }
 
+/*
+ * Build the index from each good to the bids containing it,
+ * given that the bids vector is populated
+ */
+void buildGoodsIndex() {
+    bidsContainingGood.clear();
+
+    for (Bid& bid : bids) {
+        for (int good : bid.bidGoods) {
+            bidsContainingGood[good].push_back(bid.bidId);
+        }
+    }
+}
+
 /*
  * Build the auction's conflict graph,
  * given that the bids vector is populated
  */
 void buildConflictGraph() {
     // Iterate over all pairs of bids
-    for (int bidIndex1 = 0; bidIndex1 < (bids.size() - 1); bidIndex1++) {
+    for (int bidIndex1 = 0; bidIndex1 + 1 < bids.size(); bidIndex1++) {
         for (int bidIndex2 = bidIndex1 + 1; 
                 bidIndex2 < bids.size(); bidIndex2++) {
             Bid& bid1 = bids[bidIndex1];
@@ -454,9 +534,9 @@ void buildConflictGraph() {
  * Write the auction's conflict graph to a MWVC file,
  * using the desired format
  */
-int writeGraphToMwvcFile() {
+int writeGraphToMwvcFile(std::string mwvcFileName) {
     // Create output stream for auction file
-    std::ofstream outfile("auction.mwvc");
+    std::ofstream outfile(mwvcFileName);
 
     if (outfile.is_open()) {
         // Write MWVC file header
@@ -481,28 +561,19 @@ int writeGraphToMwvcFile() {
     return 1;
 }
 
-int outputOptimalAuction(std::string mwvcOutLine1, std::string mwvcOutLine2) {
+/*
+ * Write the optimal auction to the auction results file,
+ * given the weight of the MWVC over the remaining bids
+ * and the (sorted) IDs of the bids in it
+ */
+int outputOptimalAuction(long long mwvcValue, std::vector<int>& mwvcBids) {
     try {
         // Create input stream for auction file
         std::ofstream outfile("auction_results.txt");
 
         if (outfile.is_open()) {
-            long long maxValue;
-
-            // Read MWVC value from line, if not empty
-            if (!mwvcOutLine1.empty()) {
-                // Read in MWVC value
-                int minValueStart = mwvcOutLine1.find_first_of(", ");
-                int minValueEnd = mwvcOutLine1.find_first_of(", ", minValueStart + 2);
-                int mwvcValue = std::stoll(
-                    mwvcOutLine1.substr(minValueStart + 2, minValueEnd - minValueStart - 2));
-                maxValue = totalValue - mwvcValue + excludedBidsValues;
-            }
-
-            // Take max value from kernalization step
-            else {
-                maxValue = excludedBidsValues;
-            }
+            // Remaining bids outside of the MWVC win, as do bids confirmed by kernalization
+            long long maxValue = totalValue - mwvcValue + excludedBidsValues;
 
             // Write and print MWVC file header
             outfile << maxValue << " " << std::endl;
@@ -512,42 +583,31 @@ int outputOptimalAuction(std::string mwvcOutLine1, std::string mwvcOutLine2) {
             // Fields for validating winning auction
             int totalBidsValue = 0;
 
-            // Read bids, if line not empty
-            if (!mwvcOutLine2.empty()) {
-                // Read bids
-                std::istringstream split(mwvcOutLine2);
-                char delim = ',';
-                std::vector<int> mwvcBids;
-                for (std::string each; 
-                    std::getline(split, each, delim); 
-                    mwvcBids.push_back(std::stoi(each)));
-
-                // Write and print bids in optimal auction
-                int mwvcBidsIndex = 0;
-                for (Bid& bid : bids) {
-                    // Skip over bids in MWVC bids
-                    if ((mwvcBidsIndex < mwvcBids.size() && bid.bidId == mwvcBids[mwvcBidsIndex])) {
-                        mwvcBidsIndex++;
-                    }
-
-                    // Print bids NOT in MWVC bids
-                    else {
-                        outfile << bid.value << "\t";
-                        // std::cout << bid.value << "\t";
-                        std::string separator = "";
+            // Write bids outside of the MWVC
+            int mwvcBidsIndex = 0;
+            for (Bid& bid : bids) {
+                // Skip over bids in MWVC bids
+                if ((mwvcBidsIndex < mwvcBids.size() && bid.bidId == mwvcBids[mwvcBidsIndex])) {
+                    mwvcBidsIndex++;
+                }
 
-                        // Validate winning auction value
-                        totalBidsValue += bid.value;
+                // Print bids NOT in MWVC bids
+                else {
+                    outfile << bid.value << "\t";
+                    // std::cout << bid.value << "\t";
+                    std::string separator = "";
 
-                        for (int bidGood : bid.bidGoods) {
-                            outfile << separator << bidGood;
-                            // std::cout << separator << bidGood;
-                            separator = ",";
-                        }
+                    // Validate winning auction value
+                    totalBidsValue += bid.value;
 
-                        outfile << std::endl;
-                        // std::cout << std::endl;
+                    for (int bidGood : bid.bidGoods) {
+                        outfile << separator << bidGood;
+                        // std::cout << separator << bidGood;
+                        separator = ",";
                     }
+
+                    outfile << std::endl;
+                    // std::cout << std::endl;
                 }
             }
 
@@ -574,8 +634,6 @@ int outputOptimalAuction(std::string mwvcOutLine1, std::string mwvcOutLine2) {
             // Output validation results
             std::cout << "Validated Winning Auction Value: " << totalBidsValue << std::endl;
             // std::cout << "TotalValue: " << totalValue << std::endl;
-            // std::cout << "FastWVC Line 1: " << mwvcOutLine1 << std::endl;
-            // std::cout << "FastWVC Line 2: " << mwvcOutLine2 << std::endl;
             // std::cout << "Num bids excluded via kernalization: " << bidsExcludedFromMwvcByKernalization.size() << std::endl;      
 
             outfile.close();
@@ -588,6 +646,177 @@ int outputOptimalAuction(std::string mwvcOutLine1, std::string mwvcOutLine2) {
     return 1;
 }
 
+/*
+ * Write the given winning bids to the auction results file,
+ * using the same format as outputOptimalAuction
+ */
+int outputAuctionWinners(std::vector<Bid>& winningBids) {
+    // Create output stream for auction results file
+    std::ofstream outfile("auction_results.txt");
+
+    if (outfile.is_open()) {
+        long long maxValue = 0;
+        for (Bid& bid : winningBids) {
+            maxValue += bid.value;
+        }
+
+        // Write and print auction value
+        outfile << maxValue << " " << std::endl;
+        std::cout << "MAX AUCTION VALUE: " << maxValue << std::endl;
+
+        // Write winning bids
+        for (Bid& bid : winningBids) {
+            outfile << bid.value << "\t";
+            std::string separator = "";
+
+            for (int bidGood : bid.bidGoods) {
+                outfile << separator << bidGood;
+                separator = ",";
+            }
+
+            outfile << std::endl;
+        }
+
+        outfile.close();
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Reduce the auction via simplicial bids, using only the goods index:
+ * each good defines a clique of bids, and a bid whose conflicting bids
+ * all contain one common good of it (so its closed neighborhood is a clique)
+ * and whose value is at least that of every conflicting bid wins,
+ * while every bid conflicting with it loses.
+ * Must be called before the conflict graph is built.
+ * Return the number of bids remaining to search through
+ */
+int simplicialReduce() {
+    buildGoodsIndex();
+
+    int prunedBefore0 = numPruned0;
+    int prunedBefore1 = numPruned1;
+
+    // MWVC values of bids (-1 for bids that are still undecided)
+    std::vector<int> mwvcValues(numBids, -1);
+
+    // Worklist of bids to test, initially holding every bid
+    std::vector<int> worklist;
+    std::vector<bool> queued(numBids, true);
+    for (int i = numBids - 1; i >= 0; i--) {
+        worklist.push_back(i);
+    }
+
+    while (!worklist.empty()) {
+        int bidIndex = worklist.back();
+        worklist.pop_back();
+        queued[bidIndex] = false;
+
+        if (mwvcValues[bidIndex] != -1) {
+            continue;
+        }
+
+        Bid& bid = bids[bidIndex];
+
+        // Find the good contained in the most undecided bids,
+        // the only good whose clique can be the bid's whole neighborhood
+        int cliqueGood = -1;
+        int cliqueSize = -1;
+        bool dominated = false;
+
+        for (int good : bid.bidGoods) {
+            int goodSize = 0;
+
+            for (int bidId : bidsContainingGood[good]) {
+                if (mwvcValues[bidId - 1] == -1) {
+                    goodSize++;
+
+                    if (bids[bidId - 1].value > bid.value) {
+                        dominated = true;
+                        break;
+                    }
+                }
+            }
+
+            if (dominated) {
+                break;
+            }
+
+            if (goodSize > cliqueSize) {
+                cliqueSize = goodSize;
+                cliqueGood = good;
+            }
+        }
+
+        // A conflicting bid is more valuable
+        if (dominated) {
+            continue;
+        }
+
+        // Check that every conflicting bid contains cliqueGood
+        bool simplicial = true;
+        for (int good : bid.bidGoods) {
+            if (good == cliqueGood) {
+                continue;
+            }
+
+            for (int bidId : bidsContainingGood[good]) {
+                Bid& neighbor = bids[bidId - 1];
+
+                if (mwvcValues[bidId - 1] == -1 && bidId != bid.bidId &&
+                    !std::binary_search(neighbor.bidGoods.begin(), neighbor.bidGoods.end(), cliqueGood)) {
+                    simplicial = false;
+                    break;
+                }
+            }
+
+            if (!simplicial) {
+                break;
+            }
+        }
+
+        if (!simplicial) {
+            continue;
+        }
+
+        // The bid wins and every conflicting bid loses
+        mwvcValues[bidIndex] = 0;
+        for (int bidId : bidsContainingGood[cliqueGood]) {
+            if (mwvcValues[bidId - 1] == -1) {
+                mwvcValues[bidId - 1] = 1;
+            }
+        }
+
+        // Bids conflicting with the losing bids may have become simplicial
+        for (int loserId : bidsContainingGood[cliqueGood]) {
+            if (loserId == bid.bidId) {
+                continue;
+            }
+
+            for (int good : bids[loserId - 1].bidGoods) {
+                for (int bidId : bidsContainingGood[good]) {
+                    if (mwvcValues[bidId - 1] == -1 && !queued[bidId - 1]) {
+                        worklist.push_back(bidId - 1);
+                        queued[bidId - 1] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Remove decided bids before the conflict graph is built
+    pruneBids(mwvcValues, false);
+
+    // Output number of pruned bids
+    std::cout << "Num simplicial = 0: " << numPruned0 - prunedBefore0 << std::endl;
+    std::cout << "Num simplicial = 1: " << numPruned1 - prunedBefore1 << std::endl;
+
+    // Return the number of bids remaining to search through
+    return bids.size();
+}
+
 /*
  * Kernalize conflict graph via a MWVC
  * (with LP relaxation to leverage the half-integrality property)
@@ -623,46 +852,46 @@ int kernalize() {
         model.setObjective(*objFunction, GRB_MINIMIZE);
 
         // Add edge constraints
+        std::vector<GRBConstr> edgeConstrs;
         for (Edge& edge : edges) {
-            model.addConstr(bidVars[edge.v1 - 1] + bidVars[edge.v2 - 1] >= 1.0f, "");
+            edgeConstrs.push_back(
+                model.addConstr(bidVars[edge.v1 - 1] + bidVars[edge.v2 - 1] >= 1.0f, ""));
         }
 
         // Solve
         model.optimize();
 
-        // New bid vector after pruning bids confirmed to be included/excluded from MWVC
-        std::vector<Bid> remainingBids;
+        // Keep the edge duals to guide the initial cover of the remaining bids
+        kernelEdgeDuals.clear();
+        for (int e = 0; e < (int)edges.size(); e++) {
+            double dual = edgeConstrs[e].get(GRB_DoubleAttr_Pi);
+
+            if (dual > 0.0) {
+                Bid& bid1 = bids[edges[e].v1 - 1];
+                Bid& bid2 = bids[edges[e].v2 - 1];
+                kernelEdgeDuals.insert(std::make_pair(originalEdgeKey(bid1, bid2), dual));
+            }
+        }
+
+        // MWVC values of bids after kernalization (-1 for bids that still require search)
+        std::vector<int> mwvcValues(numBids, -1);
 
         // Reconfigure bid vectors based on kernalization results
         for (int i = 0; i < numBids; i++) {
             // By the half-integrality property, assignedValue must be in {0, 0.5, 1}
             double assignedValue = bidVars[i].get(GRB_DoubleAttr_X);
 
-            // Bids confirmed to be excluded from the MWVC
+            // Bids confirmed to be excluded from/included in the MWVC
             if (assignedValue == 0.0) {
-                bidsExcludedFromMwvcByKernalization.push_back(bids[i]);
-                excludedBidsValues += bids[i].value;
-                numPruned0++;
-            }
-
-            else if (assignedValue == 1.0) {
-                includedBidsValues += bids[i].value;
-                numPruned1++;
-            }
-
-            // Ambiguous bids that still require search
-            else {
-                remainingBids.push_back(bids[i]);
+                mwvcValues[i] = 0;
+            } else if (assignedValue == 1.0) {
+                mwvcValues[i] = 1;
             }
         }
 
-        // Bids pruned
-        if (bids.size() > remainingBids.size()) {
-            // Reconfigure bids and edges in conflict graph
-            totalValue = totalValue - excludedBidsValues - includedBidsValues;
-            refactorConflictGraph(remainingBids);
-        }
-        
+        // Reconfigure bids and edges in conflict graph
+        pruneBids(mwvcValues, true);
+
         // Output number of pruned bids
         std::cout << "Num pruned = 0: " << numPruned0 << std::endl;
         std::cout << "Num pruned = 1: " << numPruned1 << std::endl;
@@ -680,22 +909,292 @@ int kernalize() {
 }
 
 /*
- * Refactor the conflict graph,
- * Removing edges containing bids "pruned" by the kernalization
+ * Remove bids whose MWVC membership has been decided by a reduction
+ * (mwvcValues[i] is 0 if bid i is excluded from the MWVC, i.e. wins,
+ * 1 if it is included in the MWVC, and -1 if it still requires search),
+ * optionally rebuilding the conflict graph over the remaining bids
  */
-void refactorConflictGraph(std::vector<Bid>& remainingBids) {
-    // Reassign IDs in remainingBids
+void pruneBids(std::vector<int>& mwvcValues, bool rebuildEdges) {
+    // New bid vector after pruning bids confirmed to be included/excluded from MWVC
+    std::vector<Bid> remainingBids;
+    long long prunedValues = 0;
+
+    for (int i = 0; i < numBids; i++) {
+        // Bids confirmed to be excluded from the MWVC
+        if (mwvcValues[i] == 0) {
+            bidsExcludedFromMwvcByKernalization.push_back(bids[i]);
+            excludedBidsValues += bids[i].value;
+            prunedValues += bids[i].value;
+            numPruned0++;
+        }
+
+        // Bids confirmed to be included in the MWVC
+        else if (mwvcValues[i] == 1) {
+            bidsIncludedInMwvcByKernalization.push_back(bids[i]);
+            includedBidsValues += bids[i].value;
+            prunedValues += bids[i].value;
+            numPruned1++;
+        }
+
+        // Ambiguous bids that still require search
+        else {
+            remainingBids.push_back(bids[i]);
+        }
+    }
+
+    // No bids pruned
+    if (bids.size() == remainingBids.size()) {
+        return;
+    }
+
+    totalValue -= prunedValues;
+
+    if (rebuildEdges) {
+        refactorConflictGraph(remainingBids);
+    } else {
+        reassignBidIds(remainingBids);
+    }
+
+    // Keep the goods index consistent with the reassigned IDs
+    if (!bidsContainingGood.empty()) {
+        buildGoodsIndex();
+    }
+}
+
+/*
+ * Replace the bids vector with remainingBids,
+ * reassigning bid IDs to be contiguous
+ */
+void reassignBidIds(std::vector<Bid>& remainingBids) {
     bids = remainingBids;
     numBids = bids.size();
 
-    std::unordered_map<int, int> reassignedIds;
     for (int bidIndex = 0; bidIndex < numBids; bidIndex++) {
-        if (bids[bidIndex].bidId != bidIndex + 1) {
-            reassignedIds.insert(std::make_pair(bids[bidIndex].bidId, bidIndex + 1));
-            bids[bidIndex].bidId = bidIndex + 1;
+        bids[bidIndex].bidId = bidIndex + 1;
+    }
+}
+
+/*
+ * Compute a quick incumbent for the remaining bids
+ * by greedily accepting bids in decreasing order of value
+ */
+long long greedyAuctionValue() {
+    std::vector<int> order(numBids);
+    for (int i = 0; i < numBids; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [](int i, int j) {
+        return bids[i].value > bids[j].value;
+    });
+
+    long long incumbentValue = 0;
+    std::unordered_set<int> soldGoods;
+    for (int i : order) {
+        bool available = true;
+        for (int good : bids[i].bidGoods) {
+            if (soldGoods.find(good) != soldGoods.end()) {
+                available = false;
+                break;
+            }
+        }
+
+        if (available) {
+            soldGoods.insert(bids[i].bidGoods.begin(), bids[i].bidGoods.end());
+            incumbentValue += bids[i].value;
         }
     }
 
+    return incumbentValue;
+}
+
+/*
+ * Fix bids via reduced costs of the set packing LP relaxation
+ * over the remaining bids, given the value of a feasible auction on them:
+ * a bid whose reduced cost pushes the LP bound below the incumbent
+ * when forced into (out of) the auction loses (wins) in every better auction.
+ * Return the number of bids remaining to search through
+ */
+int reducedCostFix(long long incumbentValue) {
+    try {
+        // Create new environment and suppress output
+        GRBEnv env;
+        env.set(GRB_IntParam_OutputFlag, 0);
+
+        // Create the LP relaxation of the set packing model
+        GRBModel model(env);
+        model.set(GRB_StringAttr_ModelName, "reduced_cost_fixer");
+
+        std::vector<GRBVar> bidVars;
+        buildGoodsIndex();
+        buildSetPackingModel(model, bidVars, GRB_CONTINUOUS);
+
+        // Solve
+        model.optimize();
+        double lpBound = model.get(GRB_DoubleAttr_ObjVal);
+        double tolerance = 1e-6;
+
+        // MWVC values of bids after fixing (-1 for bids that still require search)
+        std::vector<int> mwvcValues(numBids, -1);
+
+        for (int i = 0; i < numBids; i++) {
+            double assignedValue = bidVars[i].get(GRB_DoubleAttr_X);
+            double reducedCost = bidVars[i].get(GRB_DoubleAttr_RC);
+
+            // Forcing the bid in drops the bound below the incumbent
+            if (assignedValue <= tolerance && 
+                lpBound + reducedCost < incumbentValue - tolerance) {
+                mwvcValues[i] = 1;
+            }
+
+            // Forcing the bid out drops the bound below the incumbent
+            else if (assignedValue >= 1.0 - tolerance &&
+                lpBound - reducedCost < incumbentValue - tolerance) {
+                mwvcValues[i] = 0;
+            }
+        }
+
+        // Bids conflicting with winning bids lose
+        for (int i = 0; i < numBids; i++) {
+            if (mwvcValues[i] != 0) {
+                continue;
+            }
+
+            for (int good : bids[i].bidGoods) {
+                for (int bidId : bidsContainingGood[good]) {
+                    if (bidId != bids[i].bidId) {
+                        mwvcValues[bidId - 1] = 1;
+                    }
+                }
+            }
+        }
+
+        int prunedBefore0 = numPruned0;
+        int prunedBefore1 = numPruned1;
+
+        // Reconfigure bids and edges in conflict graph
+        pruneBids(mwvcValues, true);
+
+        // Output number of fixed bids
+        std::cout << "LP bound: " << lpBound << ", incumbent: " << incumbentValue << std::endl;
+        std::cout << "Num reduced cost fixed = 0: " << numPruned0 - prunedBefore0 << std::endl;
+        std::cout << "Num reduced cost fixed = 1: " << numPruned1 - prunedBefore1 << std::endl;
+
+        // Return the number of bids remaining to search through
+        return bids.size();
+    } catch (GRBException e) {
+        std::cout << "Error code = " << e.getErrorCode() << std::endl;
+        std::cout << e.getMessage() << std::endl;
+    } catch (...) {
+        std::cout << "Exception during optimization" << std::endl;
+    }
+
+    return -1;
+}
+
+/*
+ * Key of the edge between two bids, independent of ID reassignment
+ */
+long long originalEdgeKey(Bid& bid1, Bid& bid2) {
+    long long id1 = std::min(bid1.originalBidId, bid2.originalBidId);
+    long long id2 = std::max(bid1.originalBidId, bid2.originalBidId);
+    return (id1 << 32) | id2;
+}
+
+/*
+ * Build an initial vertex cover of the remaining conflict graph
+ * by LP-guided rounding: edges are processed in decreasing order of their
+ * kernalization LP dual, each uncovered edge paying down the residual value of
+ * both endpoints (local ratio) until one is fully paid and enters the cover.
+ * A repair step then drops cover bids whose neighbors are all in the cover,
+ * most valuable first. Return the IDs of bids in the cover
+ */
+std::vector<int> buildLpGuidedCover() {
+    std::vector<double> edgeDuals(edges.size(), 0.0);
+    std::vector<int> edgeOrder(edges.size());
+    for (int e = 0; e < (int)edges.size(); e++) {
+        auto findDual = kernelEdgeDuals.find(
+            originalEdgeKey(bids[edges[e].v1 - 1], bids[edges[e].v2 - 1]));
+
+        if (findDual != kernelEdgeDuals.end()) {
+            edgeDuals[e] = findDual -> second;
+        }
+        edgeOrder[e] = e;
+    }
+    std::stable_sort(edgeOrder.begin(), edgeOrder.end(), [&edgeDuals](int e1, int e2) {
+        return edgeDuals[e1] > edgeDuals[e2];
+    });
+
+    // Round: pay down residual values along uncovered edges
+    std::vector<double> residuals(numBids + 1, 0.0);
+    std::vector<bool> inCover(numBids + 1, false);
+    std::vector<std::vector<int>> adjacentBids(numBids + 1);
+    for (Bid& bid : bids) {
+        residuals[bid.bidId] = bid.value;
+    }
+
+    for (int e : edgeOrder) {
+        int v1 = edges[e].v1;
+        int v2 = edges[e].v2;
+        adjacentBids[v1].push_back(v2);
+        adjacentBids[v2].push_back(v1);
+
+        if (!inCover[v1] && !inCover[v2]) {
+            double payment = std::min(residuals[v1], residuals[v2]);
+            residuals[v1] -= payment;
+            residuals[v2] -= payment;
+
+            if (residuals[v1] <= 0.0) {
+                inCover[v1] = true;
+            }
+            if (residuals[v2] <= 0.0) {
+                inCover[v2] = true;
+            }
+        }
+    }
+
+    // Repair: drop redundant bids from the cover, most valuable first
+    std::vector<int> coverOrder;
+    for (int bidId = 1; bidId <= numBids; bidId++) {
+        if (inCover[bidId]) {
+            coverOrder.push_back(bidId);
+        }
+    }
+    std::stable_sort(coverOrder.begin(), coverOrder.end(), [](int id1, int id2) {
+        return bids[id1 - 1].value > bids[id2 - 1].value;
+    });
+
+    for (int bidId : coverOrder) {
+        bool redundant = true;
+        for (int neighborId : adjacentBids[bidId]) {
+            if (!inCover[neighborId]) {
+                redundant = false;
+                break;
+            }
+        }
+
+        if (redundant) {
+            inCover[bidId] = false;
+        }
+    }
+
+    std::vector<int> cover;
+    for (int bidId = 1; bidId <= numBids; bidId++) {
+        if (inCover[bidId]) {
+            cover.push_back(bidId);
+        }
+    }
+
+    return cover;
+}
+
+/*
+ * Refactor the conflict graph,
+ * Removing edges containing bids "pruned" by the kernalization
+ */
+void refactorConflictGraph(std::vector<Bid>& remainingBids) {
+    // Reassign IDs in remainingBids
+    reassignBidIds(remainingBids);
+
     // Refactor edges
     edges.clear();
     for (int bidIndex1 = 0; bidIndex1 < (numBids - 1); bidIndex1++) {
@@ -713,6 +1212,195 @@ void refactorConflictGraph(std::vector<Bid>& remainingBids) {
     }
 }
 
+/*
+ * Build an initial vertex cover of the remaining conflict graph from the
+ * winners in a previous auction results file: remaining bids matching a
+ * previous winner by value and goods stay out of the cover, all others are
+ * in it (edges between matched winners are repaired by FastWVC).
+ * Return 0 on success, 1 if the results file cannot be read
+ */
+int buildWarmStartCover(std::string resultsFileName, std::vector<int>& initialCover) {
+    std::ifstream infile(resultsFileName);
+
+    if (!infile.is_open()) {
+        return 1;
+    }
+
+    // Count the previous winners by "value<TAB>goods" line
+    std::unordered_map<std::string, int> previousWinners;
+    std::string line;
+    std::getline(infile, line);
+    while (std::getline(infile, line)) {
+        if (!line.empty()) {
+            previousWinners[line]++;
+        }
+    }
+    infile.close();
+
+    int numMatched = 0;
+    initialCover.clear();
+    for (Bid& bid : bids) {
+        std::ostringstream key;
+        key << bid.value << "\t";
+        std::string separator = "";
+        for (int bidGood : bid.bidGoods) {
+            key << separator << bidGood;
+            separator = ",";
+        }
+
+        auto findWinner = previousWinners.find(key.str());
+        if (findWinner != previousWinners.end() && findWinner->second > 0) {
+            findWinner->second--;
+            numMatched++;
+        } else {
+            initialCover.push_back(bid.bidId);
+        }
+    }
+
+    std::cout << "Warm start winners matched: " << numMatched << std::endl;
+
+    return 0;
+}
+
+/*
+ * Return a lower bound on the MWVC weight of the remaining conflict graph:
+ * the kernalization LP duals of its edges still form a feasible dual packing
+ * after any later pruning, so their sum bounds every cover
+ * (0 without kernalization duals)
+ */
+long long mwvcLowerBound() {
+    double dualSum = 0.0;
+    int numDuals = 0;
+    for (Edge& edge : edges) {
+        auto findDual = kernelEdgeDuals.find(
+            originalEdgeKey(bids[edge.v1 - 1], bids[edge.v2 - 1]));
+
+        if (findDual != kernelEdgeDuals.end()) {
+            dualSum += findDual->second;
+            numDuals++;
+        }
+    }
+
+    // Cover weights are integral, but the sum is only exact up to the
+    // rounding of its terms and Gurobi's tolerance (1e-6) on each dual,
+    // so round up only past that much noise
+    double tolerance = 1e-9 * std::max(1.0, std::fabs(dualSum)) + 1e-6 * numDuals;
+    return std::max(0LL, static_cast<long long>(std::ceil(dualSum - tolerance)));
+}
+
+/*
+ * Solve the MWVC of the conflict graph in-process with FastWVC
+ * (a portfolio of options.threads parallel searches),
+ * starting from a multilevel and/or partition-parallel solve if
+ * options.multilevel or options.partitioned is set, otherwise from
+ * initialCover (bid IDs) if it is not empty; with options.resume it
+ * continues the search saved in options.checkpointFile instead.
+ * Return the weight of the best cover found (-1 on failure)
+ * and store the sorted IDs of the bids in it in mwvcBids
+ */
+long long fastwvcSolve(FastwvcOptions& options, std::vector<int>& initialCover, std::vector<int>& mwvcBids) {
+    // Convert conflict graph to CSR form (vertex bidId - 1 for each bid)
+    std::vector<int> weights(numBids);
+    std::vector<int> rowOffsets(numBids + 1, 0);
+    std::vector<int> colIndices(2 * edges.size());
+
+    for (Bid& bid : bids) {
+        weights[bid.bidId - 1] = bid.value;
+    }
+
+    for (Edge& edge : edges) {
+        rowOffsets[edge.v1]++;
+        rowOffsets[edge.v2]++;
+    }
+    for (int v = 0; v < numBids; v++) {
+        rowOffsets[v + 1] += rowOffsets[v];
+    }
+
+    std::vector<int> fillPointers(rowOffsets.begin(), rowOffsets.end() - 1);
+    for (Edge& edge : edges) {
+        colIndices[fillPointers[edge.v1 - 1]++] = edge.v2 - 1;
+        colIndices[fillPointers[edge.v2 - 1]++] = edge.v1 - 1;
+    }
+
+    FastWVCPortfolio solver(options.threads);
+    solver.seed = 0;
+    solver.cutoff_time = options.timeLimit;
+    solver.mode = 0;
+    solver.max_steps = options.maxSteps;
+    solver.construct_threads = options.constructThreads;
+    solver.construct_time = options.constructTime;
+    solver.stall_steps = options.stallSteps;
+    solver.on_improvement = options.onImprovement;
+    solver.lower_bound = options.lowerBound;
+    solver.target_gap = options.targetGap;
+    solver.checkpoint_file = options.checkpointFile;
+    solver.checkpoint_interval = options.checkpointInterval;
+    solver.BuildInstance(numBids, weights.data(), rowOffsets.data(), colIndices.data());
+
+    // A resumed search ignores the other starting points
+    bool resumed = options.resume && !options.checkpointFile.empty() &&
+                   solver.LoadCheckpoint(options.checkpointFile) == 0;
+
+    std::vector<bool> cover;
+    if (!resumed && !initialCover.empty()) {
+        cover.assign(numBids, false);
+        for (int bidId : initialCover) {
+            cover[bidId - 1] = true;
+        }
+    }
+
+    if (!resumed && (options.multilevel || options.partitioned)) {
+        double preTime = options.timeLimit / 2;
+
+        if (options.multilevel) {
+            FastWVCMultilevel multilevelSolver(options.threads);
+            multilevelSolver.BuildInstance(numBids, weights.data(), rowOffsets.data(), colIndices.data());
+            multilevelSolver.seed = 0;
+            multilevelSolver.mode = 0;
+            multilevelSolver.construct_threads = options.constructThreads;
+            multilevelSolver.cutoff_time = options.partitioned ? preTime / 2 : preTime;
+            multilevelSolver.Solve();
+            multilevelSolver.GetBestCover(cover);
+        }
+
+        if (options.partitioned) {
+            FastWVCPartitioned partitionedSolver(options.threads);
+            partitionedSolver.BuildInstance(numBids, weights.data(), rowOffsets.data(), colIndices.data());
+            partitionedSolver.seed = 0;
+            partitionedSolver.mode = 0;
+            partitionedSolver.cutoff_time = options.multilevel ? preTime / 2 : preTime;
+            if (!cover.empty()) {
+                partitionedSolver.SetInitialCover(cover);
+            }
+            partitionedSolver.Solve();
+            partitionedSolver.GetBestCover(cover);
+        }
+
+        solver.cutoff_time = options.timeLimit - preTime;
+    }
+
+    if (!cover.empty()) {
+        solver.SetInitialCover(cover);
+    }
+
+    if (solver.Solve() != 0) {
+        return -1;
+    }
+
+    // Read bids in the best cover
+    std::vector<bool> bestCover;
+    solver.GetBestCover(bestCover);
+
+    mwvcBids.clear();
+    for (int v = 0; v < numBids; v++) {
+        if (bestCover[v]) {
+            mwvcBids.push_back(v + 1);
+        }
+    }
+
+    return solver.BestWeight();
+}
+
 /*
  * Formulate combinatorial auction as min weighted set problem
  * Solve by invoking Gurobi
@@ -770,45 +1458,15 @@ long long gurobiMwvcSolve() {
 long long gurobiSetPackingSolve() {
     try {
         // Create new environment and suppress output
-        GRBEnv* env = new GRBEnv();
-        env -> set(GRB_IntParam_OutputFlag, 0);
+        GRBEnv env;
+        env.set(GRB_IntParam_OutputFlag, 0);
 
         // Create new model
-        GRBModel model = GRBModel(*env);
+        GRBModel model(env);
         model.set(GRB_StringAttr_ModelName, "gurobi_set_packing_solver");
 
         std::vector<GRBVar> bidVars;
-
-        // Create a decision variable for each bid
-        for (int i = 0; i < numBids; i++) {
-            GRBVar newVar = model.addVar(0.0, 1.0, bids[i].value, GRB_BINARY, "");
-            bidVars.push_back(newVar);
-        }
-            
-        // Create objective function
-        GRBLinExpr* objFunction = new GRBLinExpr();
-        for (int i = 0; i < numBids; i++) {
-            GRBLinExpr* term = new GRBLinExpr(bidVars[i], bids[i].value);
-            *objFunction += *term;
-        }
-
-        // Set objective function to minimize
-        model.setObjective(*objFunction, GRB_MAXIMIZE);
-
-        // Add constraints
-        for (auto& goodAndBids : bidsContainingGood) {
-            // If a good has multiple bids, apply a constraint
-            if ((goodAndBids.second).size() > 1) {
-                // 
-                GRBLinExpr* constraint = new GRBLinExpr();
-
-                for (int bidId : goodAndBids.second) {
-                    *constraint += *(new GRBLinExpr(bidVars[bidId - 1]));
-                }
-
-                model.addConstr(*constraint <= 1.0f, "");
-            }
-        }
+        buildSetPackingModel(model, bidVars, GRB_BINARY);
 
         // Solve
         model.optimize();
@@ -822,3 +1480,423 @@ long long gurobiSetPackingSolve() {
 
     return -1;
 }
+
+/*
+ * Add the set packing formulation of the auction to model: a variable
+ * of type varType per bid (bidVars[bidId - 1]) and the objective to
+ * maximize their value with each good sold at most once,
+ * given that the goods index is populated
+ */
+void buildSetPackingModel(GRBModel& model, std::vector<GRBVar>& bidVars, char varType) {
+    // Create a decision variable for each bid
+    bidVars.clear();
+    for (int i = 0; i < numBids; i++) {
+        GRBVar newVar = model.addVar(0.0, 1.0, bids[i].value, varType, "");
+        bidVars.push_back(newVar);
+    }
+
+    // Create objective function and set it to maximize
+    GRBLinExpr objFunction;
+    for (int i = 0; i < numBids; i++) {
+        objFunction += GRBLinExpr(bidVars[i], bids[i].value);
+    }
+    model.setObjective(objFunction, GRB_MAXIMIZE);
+
+    // Add goods constraints
+    for (auto& goodAndBids : bidsContainingGood) {
+        // If a good has multiple bids, apply a constraint
+        if ((goodAndBids.second).size() > 1) {
+            GRBLinExpr constraint;
+
+            for (int bidId : goodAndBids.second) {
+                constraint += bidVars[bidId - 1];
+            }
+
+            model.addConstr(constraint <= 1.0f, "");
+        }
+    }
+}
+
+
+/*
+ * Export the current (kernalized) conflict graph as a standalone instance:
+ * kernelPrefix.mwvc (MWVC DIMACS-style), kernelPrefix.bin (binary)
+ * and kernelPrefix.lift (lifting map back to the original auction)
+ */
+int writeKernelInstance(std::string kernelPrefix) {
+    if (writeGraphToMwvcFile(kernelPrefix + ".mwvc") != 0 ||
+        writeGraphToBinaryFile(kernelPrefix + ".bin") != 0 ||
+        writeKernelLiftingMap(kernelPrefix + ".lift") != 0) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Write the conflict graph to a binary MWVC file:
+ * the magic string "MWVCBIN1", then int32 fields for the number of vertices,
+ * the number of edges, each vertex weight (in ID order)
+ * and each edge's endpoint IDs
+ */
+int writeGraphToBinaryFile(std::string binaryFileName) {
+    // Create output stream for binary file
+    std::ofstream outfile(binaryFileName, std::ios::binary);
+
+    if (outfile.is_open()) {
+        int32_t header[2] = {static_cast<int32_t>(numBids), static_cast<int32_t>(edges.size())};
+        outfile.write("MWVCBIN1", 8);
+        outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        // Write vertex weights
+        std::vector<int32_t> weights;
+        for (Bid& bid : bids) {
+            weights.push_back(bid.value);
+        }
+        outfile.write(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(int32_t));
+
+        // Write edges
+        std::vector<int32_t> endpoints;
+        for (Edge& edge : edges) {
+            endpoints.push_back(edge.v1);
+            endpoints.push_back(edge.v2);
+        }
+        outfile.write(reinterpret_cast<const char*>(endpoints.data()), endpoints.size() * sizeof(int32_t));
+
+        outfile.close();
+        return outfile.fail() ? 1 : 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Write the sidecar mapping the kernel back to the original auction:
+ * "w <bidId>" for winning bids fixed by the reductions,
+ * "l <bidId>" for losing bids fixed by the reductions and
+ * "m <kernelId> <bidId>" for each bid remaining in the kernel
+ */
+int writeKernelLiftingMap(std::string liftFileName) {
+    // Create output stream for lifting map
+    std::ofstream outfile(liftFileName);
+
+    if (outfile.is_open()) {
+        outfile << "c kernel lifting map" << std::endl;
+        outfile << "p lift " << numBids << " " 
+            << bidsExcludedFromMwvcByKernalization.size() << " "
+            << bidsIncludedInMwvcByKernalization.size() << std::endl;
+
+        for (Bid& bid : bidsExcludedFromMwvcByKernalization) {
+            outfile << "w " << bid.originalBidId << std::endl;
+        }
+
+        for (Bid& bid : bidsIncludedInMwvcByKernalization) {
+            outfile << "l " << bid.originalBidId << std::endl;
+        }
+
+        for (Bid& bid : bids) {
+            outfile << "m " << bid.bidId << " " << bid.originalBidId << std::endl;
+        }
+
+        outfile.close();
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Return whether line is FastWVC's "file, weight, time" summary line,
+ * reading its weight into weight
+ */
+bool isMwvcSummaryLine(std::string line, long long& weight) {
+    std::vector<std::string> fields;
+    std::istringstream split(line);
+    for (std::string field; std::getline(split, field, ',');) {
+        fields.push_back(field);
+    }
+
+    if (fields.size() != 3 && fields.size() != 4) {
+        return false;
+    }
+
+    // The file name is not a number, the weight and time are
+    std::istringstream fileField(fields[0]), weightField(fields[1]), timeField(fields[2]);
+    double number;
+    long long lineWeight;
+    double time;
+    std::string rest;
+    if ((fileField >> number) && !(fileField >> rest)) {
+        return false;
+    }
+    if (!(weightField >> lineWeight) || (weightField >> rest) ||
+        !(timeField >> time) || (timeField >> rest)) {
+        return false;
+    }
+
+    weight = lineWeight;
+    return true;
+}
+
+/*
+ * Lift a vertex cover of the exported kernel back into a full auction result,
+ * given that the bids vector holds the original (unreduced) auction.
+ * The solution file is FastWVC's output, whose cover (kernel IDs separated by
+ * commas, empty for an empty cover) is the line after the last
+ * "file, weight, time" summary line and must have the summary's weight;
+ * without a summary line, the file must hold the cover line alone
+ * (or nothing, for a kernel without bids)
+ */
+int liftKernelSolution(std::string kernelPrefix, std::string solutionFileName) {
+    // Create input streams for lifting map and kernel solution
+    std::ifstream liftfile(kernelPrefix + ".lift");
+    std::ifstream solutionfile(solutionFileName);
+
+    if (!liftfile.is_open() || !solutionfile.is_open()) {
+        return 1;
+    }
+
+    // Read lifting map
+    std::vector<int> winningBidIds;
+    std::unordered_map<int, int> originalIds;
+    std::string line;
+    while (std::getline(liftfile, line)) {
+        std::istringstream split(line);
+        std::string sign;
+        split >> sign;
+
+        if (sign == "w") {
+            int bidId;
+            split >> bidId;
+            winningBidIds.push_back(bidId);
+        } else if (sign == "m") {
+            int kernelId;
+            int bidId;
+            split >> kernelId >> bidId;
+            originalIds.insert(std::make_pair(kernelId, bidId));
+        }
+    }
+    liftfile.close();
+
+    // Find the cover line by position: the line after the summary line
+    // (whose first field is the graph file name, unlike the numeric
+    // --stream progress lines), else the only non-empty line
+    std::string coverLine;
+    long long summaryWeight = 0;
+    bool summaryFound = false;
+    bool afterSummary = false;
+    int numOtherLines = 0;
+    while (std::getline(solutionfile, line)) {
+        if (afterSummary) {
+            coverLine = line;
+            afterSummary = false;
+        } else if (isMwvcSummaryLine(line, summaryWeight)) {
+            summaryFound = true;
+            afterSummary = true;
+            coverLine.clear();
+        } else if (!summaryFound && line.find_first_not_of(" \t\r") != std::string::npos) {
+            coverLine = line;
+            numOtherLines++;
+        }
+    }
+    solutionfile.close();
+
+    if ((!summaryFound && (numOtherLines > 1 || (numOtherLines == 0 && !originalIds.empty()))) ||
+        coverLine.find_first_not_of("0123456789, \t\r") != std::string::npos) {
+        std::cerr << "No vertex cover line in the kernel solution file." << std::endl;
+        return 1;
+    }
+
+    // Read kernel IDs in the cover
+    std::unordered_set<int> coverIds;
+    long long coverWeight = 0;
+    std::replace(coverLine.begin(), coverLine.end(), ',', ' ');
+    std::istringstream split(coverLine);
+    for (int kernelId; split >> kernelId;) {
+        auto findId = originalIds.find(kernelId);
+        if (findId == originalIds.end() || findId -> second < 1 || findId -> second > numBids) {
+            std::cerr << "Kernel ID " << kernelId << " is not in the lifting map." << std::endl;
+            return 1;
+        }
+        if (coverIds.insert(kernelId).second) {
+            coverWeight += bids[findId -> second - 1].value;
+        }
+    }
+
+    if (summaryFound && coverWeight != summaryWeight) {
+        std::cerr << "Cover weight " << coverWeight << " does not match the summary weight "
+            << summaryWeight << "." << std::endl;
+        return 1;
+    }
+
+    // Kernel bids outside of the cover win
+    for (auto& kernelAndOriginalId : originalIds) {
+        if (coverIds.find(kernelAndOriginalId.first) == coverIds.end()) {
+            winningBidIds.push_back(kernelAndOriginalId.second);
+        }
+    }
+    std::sort(winningBidIds.begin(), winningBidIds.end());
+
+    std::vector<Bid> winningBids;
+    for (int bidId : winningBidIds) {
+        if (bidId < 1 || bidId > numBids) {
+            return 1;
+        }
+        winningBids.push_back(bids[bidId - 1]);
+    }
+
+    // Validate that no two winning bids share a good
+    std::unordered_set<int> soldGoods;
+    for (Bid& bid : winningBids) {
+        for (int good : bid.bidGoods) {
+            if (!soldGoods.insert(good).second) {
+                std::cerr << "Lifted solution is infeasible: good " << good 
+                    << " is sold more than once." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return outputAuctionWinners(winningBids);
+}
+
+/*
+ * Hash the normalized bid set (bid values and sorted goods, in bid order)
+ * into a 64-bit FNV-1a key, formatted as hex
+ */
+std::string auctionContentHash() {
+    unsigned long long hash = 14695981039346656037ULL;
+    auto mix = [&hash](long long word) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash ^= static_cast<unsigned long long>(word >> (8 * byte)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    mix(numBids);
+    for (Bid& bid : bids) {
+        mix(bid.value);
+        mix(bid.bidGoods.size());
+        for (int good : bid.bidGoods) {
+            mix(good);
+        }
+    }
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+/*
+ * Apply a cached kernel partition to the freshly read auction,
+ * building the conflict graph over the undecided bids only,
+ * and restore the kernalization LP duals of its edges.
+ * Return 0 on a cache hit, 1 on a miss
+ */
+int loadKernelCache(std::string cacheDir, std::string cacheKey) {
+    // Create input stream for cache file
+    std::ifstream infile(cacheDir + "/" + cacheKey + ".kernel");
+
+    if (infile.is_open()) {
+        std::string sign;
+        std::string tmp;
+        int cachedNumBids;
+        std::string partition;
+        int numDuals = -1;
+
+        infile >> sign >> tmp >> cachedNumBids >> partition;
+        std::string dualSign;
+        infile >> dualSign >> numDuals;
+
+        // Stale or corrupt entry (entries without duals predate them)
+        if (sign != "p" || cachedNumBids != numBids || (int)partition.size() != numBids ||
+            dualSign != "d" || numDuals < 0) {
+            return 1;
+        }
+
+        // Duals are keyed by original bid IDs, as kernalize() stores them
+        std::unordered_map<long long, double> cachedDuals;
+        for (int i = 0; i < numDuals; i++) {
+            long long id1, id2;
+            double dual;
+            if (!(infile >> sign >> id1 >> id2 >> dual) || sign != "e") {
+                return 1;
+            }
+            cachedDuals.insert(std::make_pair((std::min(id1, id2) << 32) | std::max(id1, id2), dual));
+        }
+        infile.close();
+        kernelEdgeDuals.swap(cachedDuals);
+
+        // Partition holds '0', 'h' or '1' per bid (the LP value of its MWVC variable)
+        std::vector<int> mwvcValues(numBids, -1);
+        for (int i = 0; i < numBids; i++) {
+            if (partition[i] == '0') {
+                mwvcValues[i] = 0;
+            } else if (partition[i] == '1') {
+                mwvcValues[i] = 1;
+            }
+        }
+
+        pruneBids(mwvcValues, false);
+        buildConflictGraph();
+
+        // Output number of pruned bids
+        std::cout << "Kernel cache hit: " << cacheKey << std::endl;
+        std::cout << "Num pruned = 0: " << numPruned0 << std::endl;
+        std::cout << "Num pruned = 1: " << numPruned1 << std::endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Store the kernel partition of the auction and the kernalization LP duals
+ * of the edges between its remaining bids,
+ * given that the reductions have been applied
+ */
+int storeKernelCache(std::string cacheDir, std::string cacheKey) {
+    mkdir(cacheDir.c_str(), 0755);
+
+    // Create output stream for cache file
+    std::ofstream outfile(cacheDir + "/" + cacheKey + ".kernel");
+
+    if (outfile.is_open()) {
+        int originalNumBids = numBids + bidsExcludedFromMwvcByKernalization.size() +
+            bidsIncludedInMwvcByKernalization.size();
+        std::string partition(originalNumBids, 'h');
+
+        for (Bid& bid : bidsExcludedFromMwvcByKernalization) {
+            partition[bid.originalBidId - 1] = '0';
+        }
+
+        for (Bid& bid : bidsIncludedInMwvcByKernalization) {
+            partition[bid.originalBidId - 1] = '1';
+        }
+
+        outfile << "p partition " << originalNumBids << " " << partition << std::endl;
+
+        // Only duals between remaining bids are used after loading
+        std::vector<std::pair<long long, double>> keptDuals;
+        for (auto& keyAndDual : kernelEdgeDuals) {
+            int id1 = static_cast<int>(keyAndDual.first >> 32);
+            int id2 = static_cast<int>(keyAndDual.first & 0xffffffffLL);
+            if (partition[id1 - 1] == 'h' && partition[id2 - 1] == 'h') {
+                keptDuals.push_back(keyAndDual);
+            }
+        }
+        std::sort(keptDuals.begin(), keptDuals.end());
+
+        outfile << "d " << keptDuals.size() << std::endl;
+        outfile << std::setprecision(17);
+        for (auto& keyAndDual : keptDuals) {
+            outfile << "e " << (keyAndDual.first >> 32) << " " << (keyAndDual.first & 0xffffffffLL)
+                << " " << keyAndDual.second << std::endl;
+        }
+
+        outfile.close();
+        return outfile.fail() ? 1 : 0;
+    }
+
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "mwvc.h"
+#include <sstream>
+
+/*
+ * Search throughput of each CC mode on one graph, with the search
+ * specialized on the mode and with the generic one testing it at run time
+ */
+int main(int argc, char *argv[])
+{
+    uint seed = 0;
+    double cutoff_time = 5;
+
+    if (argc < 2)
+    {
+        cout << "Usage: ./benchmark [Graph file] [Seed] [Cutoff time per mode]" << endl;
+        return 1;
+    }
+
+    stringstream ss;
+    if (argc > 2)
+    {
+        ss << argv[2];
+        ss >> seed;
+        ss.clear();
+    }
+    if (argc > 3)
+    {
+        ss << argv[3];
+        ss >> cutoff_time;
+        ss.clear();
+    }
+
+    FastWVC solver;
+    if (solver.BuildInstance(argv[1]) != 0)
+    {
+        cerr << "Open instance file failed." << endl;
+        return 1;
+    }
+
+    for (int mode = 0; mode < 4; mode++)
+    {
+        double steps_per_second[2];
+
+        for (int specialized = 1; specialized >= 0; specialized--)
+        {
+            solver.seed = seed;
+            solver.cutoff_time = cutoff_time;
+            solver.mode = mode;
+            solver.specialize_search = specialized == 1;
+            // Keep construction short so the time goes to the local search
+            solver.construct_rounds = 1;
+
+            auto start = chrono::steady_clock::now();
+            int result = solver.Solve();
+            double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            steps_per_second[specialized] = solver.StepCount() / elapsed;
+
+            cout << "mode " << mode << (specialized == 1 ? " specialized" : " generic    ")
+                 << ": weight " << solver.BestWeight()
+                 << (result == 0 ? "" : " (wrong)")
+                 << ", steps " << solver.StepCount()
+                 << ", steps/s " << (llong)steps_per_second[specialized] << endl;
+        }
+
+        cout << "mode " << mode << " speedup: " << fixed << setprecision(3)
+             << steps_per_second[1] / steps_per_second[0] << defaultfloat << endl;
+    }
+
+    return 0;
+}
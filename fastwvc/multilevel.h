@@ -0,0 +1,264 @@
+#pragma once
+
+#include "mwvc.h"
+
+/*
+ * Multilevel start for FastWVC on massive graphs: the graph is coarsened by
+ * merging pairs of non-adjacent vertices with common neighbors (the merged
+ * vertex weighs both and keeps the union of their edges, so a coarse cover
+ * expands to a fine cover of the same weight), the coarsest graph is solved,
+ * and the cover is projected back level by level, each level refined by a
+ * FastWVC portfolio warm-started from the projection
+ */
+class FastWVCMultilevel
+{
+public:
+    uint    seed;
+    double  cutoff_time;        // seconds, split evenly over the levels
+    int     mode;
+    int     num_threads;
+    int     construct_threads;
+    int     min_vertices;       // stop coarsening below this many vertices
+    int     max_levels;
+
+    FastWVCMultilevel(int);
+
+    int BuildInstance(int, const int *, const int *, const int *);
+    int Solve();
+
+    int VertexCount() const { return levels.empty() ? 0 : levels[0].v_num; }
+    int LevelCount() const { return (int)levels.size(); }
+    llong BestWeight() const { return best_weight; }
+    double BestCompTime() const { return best_comp_time; }
+    void GetBestCover(vector<bool> &cover) const { cover = best_cover; }
+
+private:
+    // Graph of one level in 0-indexed CSR form
+    struct Level
+    {
+        int         v_num;
+        vector<int> weights;
+        vector<int> row_offsets;
+        vector<int> col_indices;
+        vector<int> coarse_of;  // vertex of the next coarser level
+    };
+
+    vector<Level> levels;
+    Xoshiro128 rng;
+
+    vector<bool> best_cover;
+    llong   best_weight;
+    double  best_comp_time;
+
+    bool Coarsen(Level &, Level &);
+};
+
+FastWVCMultilevel::FastWVCMultilevel(int threads)
+{
+    seed = 0;
+    cutoff_time = 1;
+    mode = 0;
+    num_threads = threads < 1 ? 1 : threads;
+    construct_threads = 1;
+    min_vertices = 1000;
+    max_levels = 8;
+    best_weight = 0;
+    best_comp_time = 0.0;
+}
+
+int FastWVCMultilevel::BuildInstance(int num_vertices, const int *weights, const int *row_offsets, const int *col_indices)
+{
+    levels.assign(1, Level());
+    levels[0].v_num = num_vertices;
+    levels[0].weights.assign(weights, weights + num_vertices);
+    levels[0].row_offsets.assign(row_offsets, row_offsets + num_vertices + 1);
+    levels[0].col_indices.assign(col_indices, col_indices + row_offsets[num_vertices]);
+    return 0;
+}
+
+/*
+ * Build the next coarser level. Vertices are visited in random order and
+ * each unmatched one is merged with the unmatched two-hop vertex sharing the
+ * most neighbors with it (ties to the lighter one), scanning a bounded part
+ * of large neighborhoods. Return false if the graph barely shrinks
+ */
+bool FastWVCMultilevel::Coarsen(Level &fine, Level &coarse)
+{
+    const int max_scan = 32;
+    int n = fine.v_num;
+    int u, w, x, i, j;
+
+    vector<int> order(n);
+    for (u = 0; u < n; u++)
+    {
+        order[u] = u;
+    }
+    for (i = n - 1; i > 0; i--)
+    {
+        swap(order[i], order[rng.Bounded(i + 1)]);
+    }
+
+    vector<int> adjacent_to(n, -1);
+    vector<int> common(n, 0);
+    vector<int> touched;
+
+    fine.coarse_of.assign(n, -1);
+    coarse.v_num = 0;
+    coarse.weights.clear();
+
+    for (int k = 0; k < n; k++)
+    {
+        u = order[k];
+        if (fine.coarse_of[u] != -1)
+        {
+            continue;
+        }
+
+        int u_begin = fine.row_offsets[u];
+        int u_end = fine.row_offsets[u + 1];
+        for (i = u_begin; i < u_end; i++)
+        {
+            adjacent_to[fine.col_indices[i]] = u;
+        }
+
+        // Count common neighbors of u and its unmatched two-hop vertices
+        touched.clear();
+        for (i = u_begin; i < u_end && i < u_begin + max_scan; i++)
+        {
+            x = fine.col_indices[i];
+            for (j = fine.row_offsets[x]; j < fine.row_offsets[x + 1] && j < fine.row_offsets[x] + max_scan; j++)
+            {
+                w = fine.col_indices[j];
+                if (w == u || fine.coarse_of[w] != -1 || adjacent_to[w] == u)
+                {
+                    continue;
+                }
+                if (common[w]++ == 0)
+                {
+                    touched.push_back(w);
+                }
+            }
+        }
+
+        int mate = -1;
+        for (int t : touched)
+        {
+            if ((llong)fine.weights[u] + fine.weights[t] <= INT_MAX &&
+                (mate == -1 || common[t] > common[mate] ||
+                 (common[t] == common[mate] && fine.weights[t] < fine.weights[mate])))
+            {
+                mate = t;
+            }
+        }
+        for (int t : touched)
+        {
+            common[t] = 0;
+        }
+
+        fine.coarse_of[u] = coarse.v_num;
+        coarse.weights.push_back(fine.weights[u]);
+        if (mate != -1)
+        {
+            fine.coarse_of[mate] = coarse.v_num;
+            coarse.weights.back() += fine.weights[mate];
+        }
+        coarse.v_num++;
+    }
+
+    if (coarse.v_num > 0.9 * n)
+    {
+        return false;
+    }
+
+    // Contract the edges, dropping duplicates
+    vector<llong> keys;
+    for (u = 0; u < n; u++)
+    {
+        for (i = fine.row_offsets[u]; i < fine.row_offsets[u + 1]; i++)
+        {
+            int cu = fine.coarse_of[u];
+            int cx = fine.coarse_of[fine.col_indices[i]];
+            if (cu != cx)
+            {
+                keys.push_back((llong)cu * coarse.v_num + cx);
+            }
+        }
+    }
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+
+    coarse.row_offsets.assign(coarse.v_num + 1, 0);
+    coarse.col_indices.resize(keys.size());
+    for (i = 0; i < (int)keys.size(); i++)
+    {
+        coarse.row_offsets[keys[i] / coarse.v_num + 1]++;
+        coarse.col_indices[i] = (int)(keys[i] % coarse.v_num);
+    }
+    for (u = 0; u < coarse.v_num; u++)
+    {
+        coarse.row_offsets[u + 1] += coarse.row_offsets[u];
+    }
+
+    return true;
+}
+
+/*
+ * Coarsen, then solve from the coarsest level up to the original graph.
+ * Return 0 if the best cover is valid
+ */
+int FastWVCMultilevel::Solve()
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int level, v;
+    int result = 1;
+    vector<bool> cover;
+
+    rng.Seed(seed);
+    levels.resize(1);
+    while ((int)levels.size() < max_levels && levels.back().v_num > min_vertices)
+    {
+        Level coarse;
+        if (!Coarsen(levels.back(), coarse))
+        {
+            break;
+        }
+        levels.push_back(coarse);
+    }
+
+    for (level = (int)levels.size() - 1; level >= 0; level--)
+    {
+        Level &graph = levels[level];
+        FastWVCPortfolio solver(num_threads);
+
+        solver.BuildInstance(graph.v_num, graph.weights.data(), graph.row_offsets.data(), graph.col_indices.data());
+        solver.seed = seed;
+        solver.mode = mode;
+        solver.construct_threads = construct_threads;
+
+        // Levels share the remaining time evenly
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        solver.cutoff_time = max(0.0, (cutoff_time - elapsed) / (level + 1));
+
+        if (!cover.empty())
+        {
+            vector<bool> fine_cover(graph.v_num);
+            for (v = 0; v < graph.v_num; v++)
+            {
+                fine_cover[v] = cover[graph.coarse_of[v]];
+            }
+            solver.SetInitialCover(fine_cover);
+        }
+
+        result = solver.Solve();
+        solver.GetBestCover(cover);
+
+        if (level == 0)
+        {
+            best_weight = solver.BestWeight();
+            best_comp_time = elapsed + solver.BestCompTime();
+        }
+    }
+
+    best_cover = cover;
+    return result;
+}
@@ -1,21 +1,40 @@
 #include "mwvc.h"
+#include "multilevel.h"
+#include "partition.h"
 #include <sstream>
 
 int main(int argc, char *argv[])
 {
     uint seed;
+    double cutoff_time;
+    int mode;
+    int threads = 1;
+    int construct_threads = 1;
+    double construct_time = 0.0;
+    bool multilevel = false;
+    bool partitioned = false;
+    bool huge_pages = false;
+    bool stream = false;
+    llong lower_bound = 0;
+    double target_gap = 0.0;
+    llong max_steps = 0;
+    llong stall_steps = 0;
+    string init_cover_file;
+    string checkpoint_file;
+    double checkpoint_interval = 60;
+    bool resume = false;
     
     if (argc == 1)
     {
         cout << "FastWVC - a Minimum Weighted Vertex Cover Problem solver." << endl;
-        cout << "Usage: ./mwvc [Graph file] [Seed] [Cutoff time] [CC mode]" << endl;
+        cout << "Usage: ./mwvc [Graph file] [Seed] [Cutoff time] [CC mode] [Initial cover file] [--threads N] [--stream] [--lower-bound W] [--gap G] [--max-steps N] [--stall-steps N] [--construct-threads N] [--construct-time S] [--multilevel] [--partitioned] [--huge-pages] [--checkpoint FILE] [--checkpoint-interval S] [--resume]" << endl;
         return 1;
     }
 
     if (argc < 5)
     {
         cerr << "Missing argument(s)." << endl;
-        cout << "Usage: ./mwvc [Graph file] [Seed] [Cutoff time] [CC mode]" << endl;
+        cout << "Usage: ./mwvc [Graph file] [Seed] [Cutoff time] [CC mode] [Initial cover file] [--threads N] [--stream] [--lower-bound W] [--gap G] [--max-steps N] [--stall-steps N] [--construct-threads N] [--construct-time S] [--multilevel] [--partitioned] [--huge-pages] [--checkpoint FILE] [--checkpoint-interval S] [--resume]" << endl;
         return 1;
     }
 
@@ -30,10 +49,91 @@ int main(int argc, char *argv[])
     ss >> mode;
     ss.clear();
 
-    if (BuildInstance(argv[1]) != 0)
+    for (int i = 5; i < argc; i++)
     {
-        cerr << "Open instance file failed." << endl;
-        return 1;
+        string arg = argv[i];
+
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> threads;
+            ss.clear();
+        }
+        else if (arg == "--construct-threads" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> construct_threads;
+            ss.clear();
+        }
+        else if (arg == "--construct-time" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> construct_time;
+            ss.clear();
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc)
+        {
+            checkpoint_file = argv[++i];
+        }
+        else if (arg == "--checkpoint-interval" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> checkpoint_interval;
+            ss.clear();
+        }
+        else if (arg == "--resume")
+        {
+            resume = true;
+        }
+        else if (arg == "--huge-pages")
+        {
+            huge_pages = true;
+        }
+        else if (arg == "--multilevel")
+        {
+            multilevel = true;
+        }
+        else if (arg == "--partitioned")
+        {
+            partitioned = true;
+        }
+        else if (arg == "--stream")
+        {
+            stream = true;
+        }
+        else if (arg == "--lower-bound" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> lower_bound;
+            ss.clear();
+        }
+        else if (arg == "--gap" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> target_gap;
+            ss.clear();
+        }
+        else if (arg == "--max-steps" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> max_steps;
+            ss.clear();
+        }
+        else if (arg == "--stall-steps" && i + 1 < argc)
+        {
+            ss << argv[++i];
+            ss >> stall_steps;
+            ss.clear();
+        }
+        else if (arg.compare(0, 2, "--") != 0 && init_cover_file.empty())
+        {
+            init_cover_file = arg;
+        }
+        else
+        {
+            cerr << "Unknown option: " << arg << endl;
+            return 1;
+        }
     }
 
     if (seed < 0U || seed > ~0U)
@@ -41,7 +141,7 @@ int main(int argc, char *argv[])
         seed = 10;
     }
 
-    if (cutoff_time < 0 || cutoff_time > (int)(~0U>>1))
+    if (cutoff_time < 0 || cutoff_time > (double)(~0U>>1))
     {
         cutoff_time = 1000;
     }
@@ -51,24 +151,121 @@ int main(int argc, char *argv[])
         mode = 0;
     }
 
-    srand(seed);
+    if (threads < 1)
+    {
+        threads = 1;
+    }
 
-    cout << argv[1];
+    FastWVCPortfolio solver(threads);
+    solver.huge_pages = huge_pages;
 
-    start = chrono::steady_clock::now();
+    if (solver.BuildInstance(argv[1]) != 0)
+    {
+        cerr << "Open instance file failed." << endl;
+        return 1;
+    }
 
-    ConstructVC();
-    LocalSearch();
+    solver.seed = seed;
+    solver.cutoff_time = cutoff_time;
+    solver.mode = mode;
+    solver.construct_threads = construct_threads;
+    solver.construct_time = construct_time;
+    solver.max_steps = max_steps;
+    solver.stall_steps = stall_steps;
+    solver.lower_bound = lower_bound;
+    solver.target_gap = target_gap;
+    solver.checkpoint_file = checkpoint_file;
+    solver.checkpoint_interval = checkpoint_interval;
 
-    if (CheckSolution() == 1)
+    if (!init_cover_file.empty())
     {
-        cout << ", " << best_weight << ", " << best_comp_time << endl;
+        solver.LoadInitialCover(init_cover_file);
+    }
+
+    // Continue an interrupted run, counting its time towards the cutoff
+    if (resume && !checkpoint_file.empty())
+    {
+        if (solver.LoadCheckpoint(checkpoint_file) == 0)
+        {
+            multilevel = false;
+            partitioned = false;
+        }
+        else
+        {
+            cerr << "No usable checkpoint, starting over." << endl;
+        }
+    }
+
+    // Spend half of the time on a multilevel and/or partition-parallel
+    // solve and refine its cover
+    if (multilevel || partitioned)
+    {
+        vector<int> weights, row_offsets, col_indices;
+        vector<bool> cover;
+        double pre_time = cutoff_time / 2;
+        solver.GetInstance(weights, row_offsets, col_indices);
+
+        if (multilevel)
+        {
+            FastWVCMultilevel multilevel_solver(threads);
+            multilevel_solver.BuildInstance(solver.VertexCount(), weights.data(), row_offsets.data(), col_indices.data());
+            multilevel_solver.seed = seed;
+            multilevel_solver.mode = mode;
+            multilevel_solver.construct_threads = construct_threads;
+            multilevel_solver.cutoff_time = partitioned ? pre_time / 2 : pre_time;
+            multilevel_solver.Solve();
+            multilevel_solver.GetBestCover(cover);
+        }
+
+        if (partitioned)
+        {
+            FastWVCPartitioned partitioned_solver(threads);
+            partitioned_solver.BuildInstance(solver.VertexCount(), weights.data(), row_offsets.data(), col_indices.data());
+            partitioned_solver.seed = seed;
+            partitioned_solver.mode = mode;
+            partitioned_solver.cutoff_time = multilevel ? pre_time / 2 : pre_time;
+            if (!cover.empty())
+            {
+                partitioned_solver.SetInitialCover(cover);
+            }
+            partitioned_solver.Solve();
+            partitioned_solver.GetBestCover(cover);
+        }
+
+        solver.SetInitialCover(cover);
+        solver.cutoff_time = cutoff_time - pre_time;
+    }
+
+    // Print every new best as "weight, time, step" while searching
+    if (stream)
+    {
+        solver.on_improvement = [](llong weight, double time, llong step)
+        {
+            cout << weight << ", " << time << ", " << step << endl;
+        };
+    }
+
+    int result = solver.Solve();
+
+    cout << argv[1];
+
+    if (result == 0)
+    {
+        cout << ", " << solver.BestWeight() << ", " << solver.BestCompTime();
+        if (lower_bound > 0)
+        {
+            cout << ", gap " << solver.Gap();
+        }
+        cout << endl;
 
         // Added code to output vertices in WMVC
+        vector<bool> best_cover;
+        solver.GetBestCover(best_cover);
+
         std::string delim = "";
-        for (int i = 0; i <= v_num; i++) {
-            if (best_v_in_c[i]) {
-                cout << delim << i;
+        for (int i = 0; i < solver.VertexCount(); i++) {
+            if (best_cover[i]) {
+                cout << delim << i + 1;
                 delim = ",";
             }
         }
@@ -79,7 +276,5 @@ int main(int argc, char *argv[])
         cout << ", the solution is wrong." << endl;
     }
 
-    FreeMemory();
-
     return 0;
 }
@@ -9,6 +9,24 @@
 #include <random>
 #include <cmath>
 #include <cstring>
+#include <functional>
+#include <climits>
+#include <limits>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include <cstdio>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#if defined(FASTWVC_STATS) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
 
 using namespace std;
 
@@ -18,87 +36,505 @@ using namespace std;
 typedef long long llong;
 typedef unsigned int uint;
 
-struct Edge
+// Called with the weight, time (seconds) and step of every new best cover
+typedef function<void(llong, double, llong)> ImprovementCallback;
+
+// Stored edge weights are 16-bit with FASTWVC_EDGE_WEIGHT_16, halving their
+// memory traffic; they are rescaled before they could saturate
+#ifdef FASTWVC_EDGE_WEIGHT_16
+typedef uint16_t eweight;
+#else
+typedef int eweight;
+#endif
+
+// Neighbors ahead whose state Add()/Remove() prefetch
+#define PREFETCH_DISTANCE 4
+
+// With FASTWVC_STATS the local search counts its moves and times its hot
+// functions, and Solve() prints a summary; otherwise this compiles to nothing
+#ifdef FASTWVC_STATS
+#define STATS_COUNT(counter, n) (stats.counter += (n))
+#define STATS_TIME(section) StatsTimer section ## _timer(stats.section ## _ticks)
+#else
+#define STATS_COUNT(counter, n)
+#define STATS_TIME(section)
+#endif
+
+#ifdef FASTWVC_STATS
+// Cycle counter where available, nanoseconds otherwise
+#if defined(__x86_64__) || defined(__i386__)
+#define STATS_TICK_UNIT "cycles"
+inline uint64_t StatsTicks() { return __rdtsc(); }
+#else
+#define STATS_TICK_UNIT "ns"
+inline uint64_t StatsTicks()
 {
-    int v1;
-    int v2;
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+// Adds the ticks of its scope to total
+struct StatsTimer
+{
+    uint64_t &total;
+    uint64_t begin;
+
+    StatsTimer(uint64_t &counter) : total(counter), begin(StatsTicks()) {}
+    ~StatsTimer() { total += StatsTicks() - begin; }
+};
+
+// Counters of one Solve(); function times are inclusive
+struct SearchStats
+{
+    llong   steps;
+    llong   adds;
+    llong   removes;
+    llong   improvements;
+    llong   restarts;
+    llong   forgets;
+    llong   rescales;
+    llong   add_scans;      // vertices considered by ChooseAddV
+    double  search_seconds;
+
+    uint64_t construct_ticks;
+    uint64_t search_ticks;
+    uint64_t target_size_ticks;
+    uint64_t choose_remove_ticks;
+    uint64_t choose_add_ticks;
+    uint64_t add_ticks;
+    uint64_t remove_ticks;
+    uint64_t update_weight_ticks;
+    uint64_t forget_ticks;
+    uint64_t rescale_ticks;
+
+    SearchStats() { memset(this, 0, sizeof(SearchStats)); }
+};
+#endif
+
+/*
+ * Small fast generator (xoshiro128**) owned by each solver instance,
+ * seeded explicitly through SplitMix64
+ */
+class Xoshiro128
+{
+public:
+    void Seed(uint64_t seed)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            state[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+        }
+    }
+
+    inline uint32_t Next()
+    {
+        uint32_t result = Rotl(state[1] * 5, 7) * 9;
+        uint32_t t = state[1] << 9;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = Rotl(state[3], 11);
+
+        return result;
+    }
+
+    /*
+     * Uniform integer in [0, bound) by multiply-shift
+     * (Lemire's method, rejecting only in the rare biased case)
+     */
+    inline uint32_t Bounded(uint32_t bound)
+    {
+        uint64_t m = (uint64_t)Next() * bound;
+        uint32_t low = (uint32_t)m;
+
+        if (low < bound)
+        {
+            uint32_t threshold = -bound % bound;
+            while (low < threshold)
+            {
+                m = (uint64_t)Next() * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    uint32_t state[4];
+
+private:
+    static inline uint32_t Rotl(uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+};
+
+/*
+ * Single block holding all the memory of an instance, carved up by Take().
+ * Reset() is O(1) and the block is reused by the next instance while it is
+ * large enough; on Linux it can be mapped with transparent huge pages
+ */
+class Arena
+{
+public:
+    Arena() : base(0), capacity(0), used(0), huge(false), mapped(false) {}
+    ~Arena() { Release(); }
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // Room for at least bytes, from the start of the block
+    void Reserve(size_t bytes, bool huge_pages)
+    {
+        used = 0;
+        if (bytes <= capacity && huge_pages == huge)
+        {
+            return;
+        }
+
+        Release();
+        huge = huge_pages;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (huge_pages)
+        {
+            // Map a huge page more than needed and keep the 2 MB aligned
+            // part, so every page of the block can be backed by huge pages
+            const size_t huge_page = 2 << 20;
+            size_t length = (bytes + huge_page - 1) / huge_page * huge_page;
+            void *block = mmap(0, length + huge_page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (block != MAP_FAILED)
+            {
+                char *aligned = (char *)(((uintptr_t)block + huge_page - 1) & ~(uintptr_t)(huge_page - 1));
+                size_t head = aligned - (char *)block;
+                if (head > 0)
+                {
+                    munmap(block, head);
+                }
+                if (huge_page - head > 0)
+                {
+                    munmap(aligned + length, huge_page - head);
+                }
+
+                madvise(aligned, length, MADV_HUGEPAGE);
+                base = aligned;
+                capacity = length;
+                mapped = true;
+                return;
+            }
+        }
+#endif
+        void *block = 0;
+        capacity = Align(bytes);
+        if (posix_memalign(&block, 64, capacity) != 0)
+        {
+            throw bad_alloc();
+        }
+        base = (char *)block;
+    }
+
+    // Next count objects of type T (cache-line aligned, uninitialized)
+    template <class T>
+    T *Take(size_t count)
+    {
+        T *p = (T *)(base + used);
+        used += Align(count * sizeof(T));
+        return p;
+    }
+
+    void Reset() { used = 0; }
+
+    static size_t Align(size_t bytes) { return (bytes + 63) & ~(size_t)63; }
+
+private:
+    char    *base;
+    size_t  capacity;
+    size_t  used;
+    bool    huge;       // huge pages were asked for
+    bool    mapped;     // and the block was mapped with them
+
+    void Release()
+    {
+#ifdef __linux__
+        if (mapped)
+        {
+            munmap(base, capacity);
+        }
+        else
+#endif
+        {
+            free(base);
+        }
+        base = 0;
+        capacity = 0;
+        mapped = false;
+    }
+};
+
+/*
+ * Best cover shared by the workers of a portfolio:
+ * the weight is read lock-free, the cover is published under the mutex
+ */
+struct SharedIncumbent
+{
+    atomic<llong>   best_weight;
+    mutex           cover_mutex;
+    vector<int>     best_v_in_c;
+    double          best_comp_time;
+    llong           best_step;
+    ImprovementCallback on_improvement;
+
+    SharedIncumbent() : best_weight((llong)(~0ULL >> 1)), best_comp_time(0.0), best_step(0) {}
+};
+
+class FastWVC
+{
+public:
+    struct Edge
+    {
+        int v1;
+        int v2;
+    };
+
+    uint    seed;
+    double  cutoff_time;    // seconds
+    int     mode;
+
+    // Step budgets (0 for none): total steps, and steps without improvement
+    llong   max_steps;
+    llong   stall_steps;
+
+    // Randomized construction: construct_rounds restarts per thread on
+    // construct_threads threads (0 for all cores), within construct_time
+    // seconds (0 for a tenth of the cutoff, leaving the rest to the search)
+    int     construct_threads;
+    int     construct_rounds;
+    double  construct_time;
+
+    // Back the instance memory with transparent huge pages (Linux)
+    bool    huge_pages;
+
+    // Specialize the search on the CC mode at compile time; off runs the
+    // generic search testing mode at run time (for benchmarking)
+    bool    specialize_search;
+
+    SharedIncumbent *shared;
+    llong   restart_steps;
+    ImprovementCallback on_improvement;
+
+    // Stop once (best weight - lower_bound) <= target_gap * best weight
+    llong   lower_bound;
+    double  target_gap;
+
+    // Save the search state to checkpoint_file (if not empty) every
+    // checkpoint_interval seconds and when the search ends
+    string  checkpoint_file;
+    double  checkpoint_interval;
+
+    FastWVC();
+    ~FastWVC();
+
+    int BuildInstance(string);
+    int BuildInstance(int, const int *, const int *, const int *);
+    void GetInstance(vector<int> &, vector<int> &, vector<int> &) const;
+    int LoadInitialCover(string);
+    void SetInitialCover(const vector<bool> &);
+    int LoadCheckpoint(string);
+    int Solve();
+
+    // Make a running (or the next) Solve() return with the best cover so far
+    void Stop() { stop_requested.store(true); }
+
+    int VertexCount() const { return v_num; }
+    llong BestWeight() const { return best_weight; }
+    double BestCompTime() const { return best_comp_time; }
+    llong BestStep() const { return best_step; }
+    llong StepCount() const { return step; }
+    double Gap() const { return GapOf(best_weight, lower_bound); }
+    void GetBestCover(vector<bool> &) const;
+    int CheckSolution();
+
+    // Proven relative gap of a cover weight to a lower bound
+    static double GapOf(llong weight, llong bound)
+    {
+        return weight > 0 ? max(0.0, (double)(weight - bound) / weight) : 0.0;
+    }
+
+private:
+    chrono::steady_clock::time_point start;
+
+    llong   step;
+    atomic<bool> stop_requested;
+    int     try_step;
+    Xoshiro128 rng;
+
+    int     v_num;
+    int     e_num;
+
+    Edge    *edge;
+    eweight *edge_weight;
+
+    int     *dscore;
+    llong   *time_stamp;
+
+    struct Neighbor
+    {
+        int v;
+        int e;
+    };
+
+    // Adjacency in CSR form: v's (neighbor, edge) pairs are
+    // v_neighbors[v_begin[v]] .. v_neighbors[v_begin[v] + v_degree[v] - 1]
+    Neighbor *v_neighbors;
+    int     *v_begin;
+
+    // All instance arrays; every per-vertex int array is in one run, hot fields first
+    Arena   arena;
+
+    int     *v_weight;
+    int     *v_degree;
+
+    int     c_size;
+    int     *v_in_c;
+    int     *remove_cand;
+    int     *index_in_remove_cand;
+    int     remove_cand_size;
+    llong   now_weight;
+
+    int     best_c_size;
+    int     *best_v_in_c;
+    int     *best_journal;
+    int     best_journal_fill_pointer;
+    int     *in_best_journal;
+    double  best_comp_time;
+    llong   best_step;
+    llong   best_weight;
+
+    int     *uncov_stack;
+    int     uncov_stack_fill_pointer;
+    int     *index_in_uncov_stack;
+
+    int     *conf_change;
+    // v is tabu during step s if tabu_list[v] == s (stamped when added)
+    int     *tabu_list;
+
+    // Average weight and forgetting threshold in real weight units;
+    // edge_weight and dscore are stored scaled by weight_unit, so forgetting
+    // only grows the unit instead of rescaling every edge. The unit is the
+    // rounding of exact_unit, so rounding errors do not compound
+    int     ave_weight;
+    int     delta_total_weight;
+    int     threshold;
+    double  p_scale;
+    int     weight_unit;
+    double  exact_unit;
+    int     max_edge_weight;
+    int     edge_weight_limit;
+
+    vector<int> init_v_in_c;
+    llong   restart_step;
+
+#ifdef FASTWVC_STATS
+    SearchStats stats;
+    void PrintStats() const;
+#endif
+
+    // A checkpoint was loaded: the next Solve() continues its search
+    bool    resume;
+    int     resume_mode;
+    double  resume_elapsed;
+    double  last_checkpoint;
+
+    void AllocateInstance();
+    void BuildAdjacency();
+    void FreeMemory();
+    void ResetRemoveCand();
+    inline bool RemovePriorityHigher(int, int) const;
+    inline void SiftUpRemoveCand(int);
+    inline void SiftDownRemoveCand(int);
+    inline void Uncover(int);
+    inline void Cover(int);
+    void Add(int);
+    void Remove(int);
+    int UpdateTargetSize();
+    int ChooseRemoveV();
+    int ChooseAddFromV();
+    int ChooseAddV(int, int = 0);
+    inline void ConsiderAddV(int, int &, llong &, llong &) const;
+    inline void JournalChange(int);
+    inline int BestInCover(int) const;
+    void UpdateBestSolution();
+    void RemoveRedundant();
+    void ConstructVC();
+    llong ConstructRandomVC(int, int *);
+    void ConstructVCFromCover();
+    void ResetToCover(const int *);
+    void InitCoverScores();
+    void PublishBestSolution();
+    void RestartFromIncumbent();
+    void ForgetEdgeWeights();
+    void RescaleEdgeWeights();
+    void InitLocalSearch();
+    int SaveCheckpoint(string);
+    uint64_t InstanceFingerprint() const;
+    template <class T> static void WriteValues(ofstream &, const T *, size_t);
+    template <class T> static void ReadValues(ifstream &, T *, size_t);
+    // CC mode as a template parameter, whose bits are tested at compile
+    // time: mode % 2 (weight increases also reset the configuration) and
+    // mode / 2 (edge weights are forgotten); -1 tests mode at run time
+    template <int cc_mode> bool WeightCC() const { return cc_mode >= 0 ? cc_mode % 2 == 1 : mode % 2 == 1; }
+    template <int cc_mode> bool Forgetting() const { return cc_mode >= 0 ? cc_mode / 2 == 1 : mode / 2 == 1; }
+    template <int cc_mode> void UpdateEdgeWeight();
+    template <int cc_mode> void LocalSearch();
+    void LocalSearch();
+    bool GapClosed() const;
+    double TimeElapsed();
 };
 
-chrono::steady_clock::time_point start;
-
-llong   max_steps;
-llong   step;
-int     try_step;
-uint    seed;
-int     cutoff_time;
-int     mode;
-
-int     v_num;
-int     e_num;
-
-Edge    *edge;
-int     *edge_weight;
-
-int     *dscore;
-llong   *time_stamp;
-
-int     *v_weight;
-int     **v_edges;
-int     **v_adj;
-int     *v_degree;
-
-int     c_size;
-int     *v_in_c;
-int     *remove_cand;
-int     *index_in_remove_cand;
-int     remove_cand_size;
-llong   now_weight;
-
-int     best_c_size;
-int     *best_v_in_c;
-double  best_comp_time;
-llong   best_step;
-llong   best_weight;
-
-int     *uncov_stack;
-int     uncov_stack_fill_pointer;
-int     *index_in_uncov_stack;
-
-int     *conf_change;
-int     *tabu_list;
-
-int     ave_weight;
-int     delta_total_weight;
-int     threshold;
-double  p_scale;
-
-int BuildInstance(string);
-void FreeMemory();
-void ResetRemoveCand();
-inline void Uncover(int);
-inline void Cover(int);
-void Add(int);
-void Remove(int);
-int UpdateTargetSize();
-int ChooseRemoveV();
-int ChooseAddV(int, int);
-void UpdateBestSolution();
-void RemoveRedundant();
-void ConstructVC();
-int CheckSolution();
-void ForgetEdgeWeights();
-void UpdateEdgeWeight();
-void LocalSearch();
-double TimeElapsed();
-
-double TimeElapsed()
+FastWVC::FastWVC()
+{
+    seed = 0;
+    cutoff_time = 1;
+    mode = 0;
+    max_steps = 0;
+    stall_steps = 0;
+    construct_threads = 1;
+    construct_rounds = 50;
+    construct_time = 0.0;
+    huge_pages = false;
+    specialize_search = true;
+    shared = 0;
+    restart_steps = 50000;
+    stop_requested = false;
+    lower_bound = 0;
+    target_gap = 0.0;
+    checkpoint_interval = 60.0;
+    resume = false;
+    v_num = 0;
+    e_num = 0;
+    edge = 0;
+    best_weight = 0;
+    best_comp_time = 0.0;
+    best_step = 0;
+}
+
+FastWVC::~FastWVC()
+{
+    FreeMemory();
+}
+
+double FastWVC::TimeElapsed()
 {
     chrono::steady_clock::time_point finish = chrono::steady_clock::now();
     chrono::duration<double> duration = finish - start;
     return duration.count();
 }
 
-int BuildInstance(string filename)
+int FastWVC::BuildInstance(string filename)
 {
     string tmp;
     string sign;
@@ -111,58 +547,164 @@ int BuildInstance(string filename)
         return 1;
     }
 
+    FreeMemory();
     infile >> sign >> tmp >> v_num >> e_num;
+    AllocateInstance();
+
+    for (v = 1; v < v_num + 1; v++)
+    {
+        infile >> sign >> tmp >> v_weight[v];
+    }
+
+    for (e = 0; e < e_num; e++)
+    {
+        infile >> tmp >> v1 >> v2;
+        edge[e].v1 = v1;
+        edge[e].v2 = v2;
+    }
+    infile.close();
+
+    BuildAdjacency();
+
+    return 0;
+}
+
+/*
+ * Build the instance from an in-memory graph in CSR form:
+ * vertices are 0-indexed, the neighbors of vertex v are
+ * col_indices[row_offsets[v]] .. col_indices[row_offsets[v + 1] - 1]
+ * and each undirected edge is listed from both endpoints
+ */
+int FastWVC::BuildInstance(int num_vertices, const int *weights, const int *row_offsets, const int *col_indices)
+{
+    int u, i, e;
+
+    FreeMemory();
+    v_num = num_vertices;
+    e_num = 0;
+    for (u = 0; u < num_vertices; u++)
+    {
+        for (i = row_offsets[u]; i < row_offsets[u + 1]; i++)
+        {
+            if (u < col_indices[i])
+            {
+                e_num++;
+            }
+        }
+    }
+    AllocateInstance();
+
+    e = 0;
+    for (u = 0; u < num_vertices; u++)
+    {
+        v_weight[u + 1] = weights[u];
+        for (i = row_offsets[u]; i < row_offsets[u + 1]; i++)
+        {
+            if (u < col_indices[i])
+            {
+                edge[e].v1 = u + 1;
+                edge[e].v2 = col_indices[i] + 1;
+                e++;
+            }
+        }
+    }
+
+    BuildAdjacency();
+
+    return 0;
+}
+
+/*
+ * Export the instance in the 0-indexed CSR form taken by BuildInstance
+ */
+void FastWVC::GetInstance(vector<int> &weights, vector<int> &row_offsets, vector<int> &col_indices) const
+{
+    int v, i;
+
+    weights.resize(v_num);
+    row_offsets.resize(v_num + 1);
+    col_indices.resize(2 * e_num);
 
-    edge = new Edge[e_num];
-    edge_weight = new int[e_num];
-    uncov_stack = new int[e_num];
-    index_in_uncov_stack = new int[e_num];
-    dscore = new int[v_num + 1];
-    time_stamp = new llong[v_num + 1];
-    v_edges = new int *[v_num + 1];
-    v_adj = new int *[v_num + 1];
-    v_degree = new int[v_num + 1];
-    v_weight = new int[v_num + 1];
-    v_in_c = new int[v_num + 1];
-    remove_cand = new int[v_num + 1];
-    index_in_remove_cand = new int[v_num + 1];
-    best_v_in_c = new int[v_num + 1];
-    conf_change = new int[v_num + 1];
-    tabu_list = new int[v_num + 1];
+    for (v = 1; v < v_num + 1; v++)
+    {
+        weights[v - 1] = v_weight[v];
+        row_offsets[v - 1] = v_begin[v];
+    }
+    row_offsets[v_num] = 2 * e_num;
+
+    for (i = 0; i < 2 * e_num; i++)
+    {
+        col_indices[i] = v_neighbors[i].v - 1;
+    }
+}
+
+void FastWVC::AllocateInstance()
+{
+    int i;
+    int *v_arrays[12];
+
+    arena.Reserve(Arena::Align(sizeof(Edge) * e_num) + Arena::Align(sizeof(eweight) * e_num) +
+                  2 * Arena::Align(sizeof(int) * e_num) + Arena::Align(sizeof(Neighbor) * 2 * e_num) + Arena::Align(sizeof(llong) * (v_num + 1)) +
+                  Arena::Align(sizeof(int) * 12 * (v_num + 1)), huge_pages);
+
+    edge = arena.Take<Edge>(e_num);
+    edge_weight = arena.Take<eweight>(e_num);
+    uncov_stack = arena.Take<int>(e_num);
+    index_in_uncov_stack = arena.Take<int>(e_num);
+    v_neighbors = arena.Take<Neighbor>(2 * e_num);
+    time_stamp = arena.Take<llong>(v_num + 1);
+
+    int *v_block = arena.Take<int>(12 * (v_num + 1));
+    for (i = 0; i < 12; i++)
+    {
+        v_arrays[i] = v_block + i * (v_num + 1);
+    }
+    v_in_c = v_arrays[0];
+    dscore = v_arrays[1];
+    conf_change = v_arrays[2];
+    index_in_remove_cand = v_arrays[3];
+    v_weight = v_arrays[4];
+    tabu_list = v_arrays[5];
+    v_degree = v_arrays[6];
+    v_begin = v_arrays[7];
+    remove_cand = v_arrays[8];
+    best_v_in_c = v_arrays[9];
+    best_journal = v_arrays[10];
+    in_best_journal = v_arrays[11];
 
     fill_n(v_degree, v_num + 1, 0);
     fill_n(tabu_list, v_num + 1, 0);
     fill_n(v_in_c, v_num + 1, 0);
+    fill_n(best_v_in_c, v_num + 1, 0);
+    fill_n(in_best_journal, v_num + 1, 0);
+    best_journal_fill_pointer = 0;
     fill_n(dscore, v_num + 1, 0);
     fill_n(conf_change, v_num + 1, 1);
     fill_n(time_stamp, v_num + 1, 0);
     fill_n(edge_weight, e_num, 1);
+    init_v_in_c.clear();
+    resume = false;
+}
 
-    for (v = 1; v < v_num + 1; v++)
-    {
-        infile >> sign >> tmp >> v_weight[v];
-    }
+void FastWVC::BuildAdjacency()
+{
+    int v, e;
+    int v1, v2;
 
     for (e = 0; e < e_num; e++)
     {
-        infile >> tmp >> v1 >> v2;
-        v_degree[v1]++;
-        v_degree[v2]++;
-
-        edge[e].v1 = v1;
-        edge[e].v2 = v2;
+        v_degree[edge[e].v1]++;
+        v_degree[edge[e].v2]++;
     }
-    infile.close();
 
-    v_adj[0] = 0;
-    v_edges[0] = 0;
+    v_begin[0] = 0;
     for (v = 1; v < v_num + 1; v++)
     {
-        v_adj[v] = new int[v_degree[v]];
-        v_edges[v] = new int[v_degree[v]];
+        v_begin[v] = v_begin[v - 1] + v_degree[v - 1];
     }
 
-    int *v_degree_tmp = new int[v_num + 1];
+    // remove_cand is not in use yet and holds the fill counts
+    int *v_degree_tmp = remove_cand;
     fill_n(v_degree_tmp, v_num + 1, 0);
 
     for (e = 0; e < e_num; e++)
@@ -170,47 +712,33 @@ int BuildInstance(string filename)
         v1 = edge[e].v1;
         v2 = edge[e].v2;
 
-        v_edges[v1][v_degree_tmp[v1]] = e;
-        v_edges[v2][v_degree_tmp[v2]] = e;
+        v_neighbors[v_begin[v1] + v_degree_tmp[v1]].v = v2;
+        v_neighbors[v_begin[v1] + v_degree_tmp[v1]].e = e;
 
-        v_adj[v1][v_degree_tmp[v1]] = v2;
-        v_adj[v2][v_degree_tmp[v2]] = v1;
+        v_neighbors[v_begin[v2] + v_degree_tmp[v2]].v = v1;
+        v_neighbors[v_begin[v2] + v_degree_tmp[v2]].e = e;
 
         v_degree_tmp[v1]++;
         v_degree_tmp[v2]++;
     }
-    delete[] v_degree_tmp;
-
-    return 0;
 }
 
-void FreeMemory()
+void FastWVC::FreeMemory()
 {
-    int v;
-    for (v = 0; v < v_num + 1; v++)
+    if (edge == 0)
     {
-        delete[] v_adj[v];
-        delete[] v_edges[v];
+        return;
     }
 
-    delete[] conf_change;
-    delete[] best_v_in_c;
-    delete[] index_in_remove_cand;
-    delete[] remove_cand;
-    delete[] v_in_c;
-    delete[] v_weight;
-    delete[] v_degree;
-    delete[] v_adj;
-    delete[] v_edges;
-    delete[] time_stamp;
-    delete[] dscore;
-    delete[] index_in_uncov_stack;
-    delete[] uncov_stack;
-    delete[] edge_weight;
-    delete[] edge;
+    // The arena keeps its block for the next instance
+    arena.Reset();
+
+    edge = 0;
+    v_num = 0;
+    e_num = 0;
 }
 
-void ResetRemoveCand()
+void FastWVC::ResetRemoveCand()
 {
     int v;
     int j = 0;
@@ -230,15 +758,75 @@ void ResetRemoveCand()
     }
 
     remove_cand_size = j;
+
+    for (j = remove_cand_size / 2 - 1; j >= 0; j--)
+    {
+        SiftDownRemoveCand(j);
+    }
 }
 
-inline void Uncover(int e)
+/*
+ * remove_cand is kept as an indexed max-heap on the removal priority
+ * v_weight / |dscore| (infinite for redundant vertices), so the best vertex
+ * to remove is always remove_cand[0]. Priorities are compared by
+ * cross-multiplication, as dscore <= 0 for every vertex in the cover
+ */
+inline bool FastWVC::RemovePriorityHigher(int v1, int v2) const
+{
+    return (llong)v_weight[v1] * -dscore[v2] > (llong)v_weight[v2] * -dscore[v1];
+}
+
+inline void FastWVC::SiftUpRemoveCand(int index)
+{
+    int v = remove_cand[index];
+    int parent;
+
+    while (index > 0)
+    {
+        parent = (index - 1) / 2;
+        if (!RemovePriorityHigher(v, remove_cand[parent]))
+        {
+            break;
+        }
+        remove_cand[index] = remove_cand[parent];
+        index_in_remove_cand[remove_cand[index]] = index;
+        index = parent;
+    }
+    remove_cand[index] = v;
+    index_in_remove_cand[v] = index;
+}
+
+inline void FastWVC::SiftDownRemoveCand(int index)
+{
+    int v = remove_cand[index];
+    int child;
+
+    while ((child = 2 * index + 1) < remove_cand_size)
+    {
+        if (child + 1 < remove_cand_size &&
+            RemovePriorityHigher(remove_cand[child + 1], remove_cand[child]))
+        {
+            child++;
+        }
+        if (!RemovePriorityHigher(remove_cand[child], v))
+        {
+            break;
+        }
+        remove_cand[index] = remove_cand[child];
+        index_in_remove_cand[remove_cand[index]] = index;
+        index = child;
+    }
+    remove_cand[index] = v;
+    index_in_remove_cand[v] = index;
+}
+
+inline void FastWVC::Uncover(int e)
 {
     index_in_uncov_stack[e] = uncov_stack_fill_pointer;
     push(e, uncov_stack);
 }
 
-inline void Cover(int e)
+inline void FastWVC::Cover(int e)
 {
     int index, last_uncov_edge;
     last_uncov_edge = pop(uncov_stack);
@@ -247,11 +835,14 @@ inline void Cover(int e)
     index_in_uncov_stack[last_uncov_edge] = index;
 }
 
-void Add(int v)
+void FastWVC::Add(int v)
 {
     int i, e, n;
     int edge_count = v_degree[v];
+    STATS_TIME(add);
+    STATS_COUNT(adds, 1);
 
+    JournalChange(v);
     v_in_c[v] = 1;
     c_size++;
     dscore[v] = -dscore[v];
@@ -259,11 +850,22 @@ void Add(int v)
 
     remove_cand[remove_cand_size] = v;
     index_in_remove_cand[v] = remove_cand_size++;
+    SiftUpRemoveCand(remove_cand_size - 1);
+
+    Neighbor *neighbors = v_neighbors + v_begin[v];
 
     for (i = 0; i < edge_count; i++)
     {
-        e = v_edges[v][i];
-        n = v_adj[v][i];
+        if (i + PREFETCH_DISTANCE < edge_count)
+        {
+            n = neighbors[i + PREFETCH_DISTANCE].v;
+            __builtin_prefetch(&v_in_c[n]);
+            __builtin_prefetch(&dscore[n], 1);
+            __builtin_prefetch(&edge_weight[neighbors[i + PREFETCH_DISTANCE].e]);
+        }
+
+        e = neighbors[i].e;
+        n = neighbors[i].v;
 
         if (v_in_c[n] == 0)
         {
@@ -273,16 +875,21 @@ void Add(int v)
         }
         else
         {
+            // |dscore| of n shrinks, raising its removal priority
             dscore[n] += edge_weight[e];
+            SiftUpRemoveCand(index_in_remove_cand[n]);
         }
     }
 }
 
-void Remove(int v)
+void FastWVC::Remove(int v)
 {
     int i, e, n;
     int edge_count = v_degree[v];
+    STATS_TIME(remove);
+    STATS_COUNT(removes, 1);
 
+    JournalChange(v);
     v_in_c[v] = 0;
     c_size--;
     dscore[v] = -dscore[v];
@@ -290,16 +897,31 @@ void Remove(int v)
 
     int last_remove_cand_v = remove_cand[--remove_cand_size];
     int index = index_in_remove_cand[v];
-    remove_cand[index] = last_remove_cand_v;
-    index_in_remove_cand[last_remove_cand_v] = index;
     index_in_remove_cand[v] = 0;
+    if (index < remove_cand_size)
+    {
+        remove_cand[index] = last_remove_cand_v;
+        index_in_remove_cand[last_remove_cand_v] = index;
+        SiftUpRemoveCand(index);
+        SiftDownRemoveCand(index_in_remove_cand[last_remove_cand_v]);
+    }
 
     now_weight -= v_weight[v];
 
+    Neighbor *neighbors = v_neighbors + v_begin[v];
+
     for (i = 0; i < edge_count; i++)
     {
-        e = v_edges[v][i];
-        n = v_adj[v][i];
+        if (i + PREFETCH_DISTANCE < edge_count)
+        {
+            n = neighbors[i + PREFETCH_DISTANCE].v;
+            __builtin_prefetch(&v_in_c[n]);
+            __builtin_prefetch(&dscore[n], 1);
+            __builtin_prefetch(&edge_weight[neighbors[i + PREFETCH_DISTANCE].e]);
+        }
+
+        e = neighbors[i].e;
+        n = neighbors[i].v;
 
         if (v_in_c[n] == 0)
         {
@@ -309,246 +931,239 @@ void Remove(int v)
         }
         else
         {
+            // |dscore| of n grows, lowering its removal priority
             dscore[n] -= edge_weight[e];
+            SiftDownRemoveCand(index_in_remove_cand[n]);
         }
     }
 }
 
-int UpdateTargetSize()
+int FastWVC::UpdateTargetSize()
 {
-    int v;
-    int best_remove_v;
-    double best_dscore;
-    double dscore_v;
-
-    best_remove_v = remove_cand[0];
-    best_dscore = (double)v_weight[best_remove_v] / (double)abs(dscore[best_remove_v]);
-
-    if (dscore[best_remove_v] != 0)
-    {
-        for (int i = 1; i < remove_cand_size; i++)
-        {
-            v = remove_cand[i];
-            if (dscore[v] == 0) break;
-            dscore_v = (double)v_weight[v] / (double)abs(dscore[v]);
-            if (dscore_v > best_dscore)
-            {
-                best_dscore = dscore_v;
-                best_remove_v = v;
-            }
-        }
-    }
+    STATS_TIME(target_size);
+    int best_remove_v = remove_cand[0];
 
     Remove(best_remove_v);
 
     return best_remove_v;
 }
 
-int ChooseRemoveV()
+/*
+ * Sample candidates and keep the one with the highest weight / |dscore|
+ * (ties to the older one), comparing ratios by cross-multiplication
+ */
+int FastWVC::ChooseRemoveV()
 {
     int i, v;
-    double dscore_v, dscore_remove_v;
-    int remove_v = remove_cand[rand() % remove_cand_size];
+    llong lhs, rhs;
+    int remove_v = remove_cand[rng.Bounded(remove_cand_size)];
+    llong remove_weight = v_weight[remove_v];
+    llong remove_dscore = abs(dscore[remove_v]);
     int to_try = 50;
+    STATS_TIME(choose_remove);
 
     for (i = 1; i < to_try; i++)
     {
-        v = remove_cand[rand() % remove_cand_size];
-        dscore_v = (double)v_weight[v] / (double)abs(dscore[v]);
-        dscore_remove_v = (double)v_weight[remove_v] / (double)abs(dscore[remove_v]);
+        v = remove_cand[rng.Bounded(remove_cand_size)];
 
-        if (tabu_list[v] == 1)
+        if (tabu_list[v] == (int)step)
         {
             continue;
         }
-        if (dscore_v < dscore_remove_v)
-        {
-            continue;
-        }
-        if (dscore_v > dscore_remove_v)
-        {
-            remove_v = v;
-        }
-        else if (time_stamp[v] < time_stamp[remove_v])
+
+        lhs = v_weight[v] * remove_dscore;
+        rhs = remove_weight * abs(dscore[v]);
+        if (lhs > rhs || (lhs == rhs && time_stamp[v] < time_stamp[remove_v]))
         {
             remove_v = v;
+            remove_weight = v_weight[v];
+            remove_dscore = abs(dscore[v]);
         }
     }
     return remove_v;
 }
 
-int ChooseAddFromV()
+/*
+ * Keep v as the vertex to add if it is out of the cover, its configuration
+ * changed and its dscore / weight beats add_v's (ties to the older one).
+ * Ratios are compared by cross-multiplication and the choice among
+ * eligible vertices is made without branches
+ */
+inline void FastWVC::ConsiderAddV(int v, int &add_v, llong &add_dscore, llong &add_weight) const
+{
+    if (v_in_c[v] == 1 || conf_change[v] == 0)
+    {
+        return;
+    }
+
+    llong lhs = dscore[v] * add_weight;
+    llong rhs = add_dscore * v_weight[v];
+    bool take = (lhs > rhs) | ((lhs == rhs) & (time_stamp[v] < time_stamp[add_v]));
+
+    add_v = take ? v : add_v;
+    add_dscore = take ? dscore[v] : add_dscore;
+    add_weight = take ? v_weight[v] : add_weight;
+}
+
+int FastWVC::ChooseAddFromV()
 {
     int v;
     int add_v = 0;
-    double improvemnt = 0.0;
-    double dscore_v;
+    llong add_dscore = 0;
+    llong add_weight = 1;
 
     for (v = 1; v < v_num + 1; v++)
     {
-        if (v_in_c[v] == 1)
-        {
-            continue;
-        }
-        if (conf_change[v] == 0)
-        {
-            continue;
-        }
-        dscore_v = (double)dscore[v] / (double)v_weight[v];
-        if (dscore_v > improvemnt)
-        {
-            improvemnt = dscore_v;
-            add_v = v;
-        }
-        else if (dscore_v == improvemnt)
-        {
-            if (time_stamp[v] < time_stamp[add_v])
-            {
-                add_v = v;
-            }
-        }
+        ConsiderAddV(v, add_v, add_dscore, add_weight);
     }
     return add_v;
 }
 
-int ChooseAddV(int remove_v, int update_v = 0)
+/*
+ * Choose the vertex to add among remove_v, update_v (if any) and their
+ * neighbors; only vertices with a positive dscore qualify
+ */
+int FastWVC::ChooseAddV(int remove_v, int update_v)
 {
-    int i, v;
+    int i;
     int add_v = 0;
-    double improvemnt = 0.0;
-    double dscore_v;
+    llong add_dscore = 0;
+    llong add_weight = 1;
+    STATS_TIME(choose_add);
+    STATS_COUNT(add_scans, v_degree[remove_v] + 1 + (update_v != 0 ? v_degree[update_v] + 1 : 0));
 
     int tmp_degree = v_degree[remove_v];
-
-    int degree_sum;
-    int *adjp = v_adj[remove_v];
+    Neighbor *neighbors = v_neighbors + v_begin[remove_v];
     for (i = 0; i < tmp_degree; i++)
     {
-        v = adjp[i];
-        if (v_in_c[v] == 1)
-        {
-            continue;
-        }
-        if (conf_change[v] == 0)
-        {
-            continue;
-        }
-        dscore_v = (double)dscore[v] / (double)v_weight[v];
-        if (dscore_v > improvemnt)
-        {
-            improvemnt = dscore_v;
-            add_v = v;
-        }
-        else if (dscore_v == improvemnt)
-        {
-            if (time_stamp[v] < time_stamp[add_v])
-            {
-                add_v = v;
-            }
-        }
-    }
-    v = remove_v;
-    if (conf_change[v] == 1 && v_in_c[v] == 0)
-    {
-        dscore_v = (double)dscore[v] / (double)v_weight[v];
-        if (dscore_v > improvemnt)
-        {
-            improvemnt = dscore_v;
-            add_v = v;
-        }
-        else if (dscore_v == improvemnt)
-        {
-            if (time_stamp[v] < time_stamp[add_v])
-            {
-                add_v = v;
-            }
-        }
-
+        ConsiderAddV(neighbors[i].v, add_v, add_dscore, add_weight);
     }
+    ConsiderAddV(remove_v, add_v, add_dscore, add_weight);
 
     if (update_v != 0)
     {
         tmp_degree = v_degree[update_v];
-        adjp = v_adj[update_v];
+        neighbors = v_neighbors + v_begin[update_v];
         for (i = 0; i < tmp_degree; i++)
         {
-            v = adjp[i];
-            if (v_in_c[v] == 1)
-            {
-                continue;
-            }
-            if (conf_change[v] == 0)
-            {
-                continue;
-            }
-            dscore_v = (double)dscore[v] / (double)v_weight[v];
-            if (dscore_v > improvemnt)
-            {
-                improvemnt = dscore_v;
-                add_v = v;
-            }
-            else if (dscore_v == improvemnt)
-            {
-                if (time_stamp[v] < time_stamp[add_v])
-                {
-                    add_v = v;
-                }
-            }
-        }
-        v = update_v;
-        if (conf_change[v] == 1 && v_in_c[v] == 0)
-        {
-            dscore_v = (double)dscore[v] / (double)v_weight[v];
-            if (dscore_v > improvemnt)
-            {
-                improvemnt = dscore_v;
-                add_v = v;
-            }
-            else if (dscore_v == improvemnt)
-            {
-                if (time_stamp[v] < time_stamp[add_v])
-                {
-                    add_v = v;
-                }
-            }
+            ConsiderAddV(neighbors[i].v, add_v, add_dscore, add_weight);
         }
-
+        ConsiderAddV(update_v, add_v, add_dscore, add_weight);
     }
 
     return add_v;
 }
-void UpdateBestSolution()
+/*
+ * Record the best-solution state of v before its first change since the
+ * last improvement, so the best cover is the current one with these undone
+ */
+inline void FastWVC::JournalChange(int v)
 {
-    int v;
+    if (in_best_journal[v] == 0)
+    {
+        in_best_journal[v] = 1;
+        best_v_in_c[v] = v_in_c[v];
+        push(v, best_journal);
+    }
+}
+
+inline int FastWVC::BestInCover(int v) const
+{
+    return in_best_journal[v] == 1 ? best_v_in_c[v] : v_in_c[v];
+}
 
+void FastWVC::UpdateBestSolution()
+{
     if (now_weight < best_weight)
     {
-        for (v = 1; v < v_num + 1; v++)
+        // The current cover becomes the best one: drop the journal
+        while (best_journal_fill_pointer > 0)
         {
-            best_v_in_c[v] = v_in_c[v];
+            in_best_journal[pop(best_journal)] = 0;
         }
         best_weight = now_weight;
         best_c_size = c_size;
         best_comp_time = TimeElapsed();
         best_step = step;
+        restart_step = step;
+        STATS_COUNT(improvements, 1);
+
+        if (on_improvement)
+        {
+            on_improvement(best_weight, best_comp_time, best_step);
+        }
+        if (shared != 0)
+        {
+            PublishBestSolution();
+        }
     }
 }
 
-void RemoveRedundant()
+/*
+ * Lower the shared best weight to ours if it is better,
+ * publishing our best cover along with it
+ */
+void FastWVC::PublishBestSolution()
 {
-    int v;
-    for (int i = 0; i < remove_cand_size; i++)
+    llong shared_weight = shared->best_weight.load(memory_order_relaxed);
+
+    while (best_weight < shared_weight)
     {
-        v = remove_cand[i];
-        if (v_in_c[v] == 1 && dscore[v] == 0)
+        if (shared->best_weight.compare_exchange_weak(shared_weight, best_weight))
         {
-            Remove(v);
-            i--;
+            lock_guard<mutex> lock(shared->cover_mutex);
+
+            // A better cover may have been published in the meantime
+            if (shared->best_weight.load() == best_weight)
+            {
+                shared->best_v_in_c.resize(v_num + 1);
+                for (int v = 0; v < v_num + 1; v++)
+                {
+                    shared->best_v_in_c[v] = BestInCover(v);
+                }
+                shared->best_comp_time = best_comp_time;
+                shared->best_step = best_step;
+
+                if (shared->on_improvement)
+                {
+                    shared->on_improvement(best_weight, best_comp_time, best_step);
+                }
+            }
+            return;
         }
     }
 }
 
-void ConstructVC()
+/*
+ * Continue the search from the shared best cover
+ */
+void FastWVC::RestartFromIncumbent()
+{
+    vector<int> cover;
+    STATS_COUNT(restarts, 1);
+    {
+        lock_guard<mutex> lock(shared->cover_mutex);
+        if ((int)shared->best_v_in_c.size() != v_num + 1)
+        {
+            return;
+        }
+        cover = shared->best_v_in_c;
+    }
+
+    ResetToCover(cover.data());
+    restart_step = step;
+}
+
+void FastWVC::RemoveRedundant()
+{
+    // Redundant vertices (dscore == 0) have the highest removal priority
+    while (remove_cand_size > 0 && dscore[remove_cand[0]] == 0)
+    {
+        Remove(remove_cand[0]);
+    }
+}
+
+void FastWVC::ConstructVC()
 {
     int e;
     int v1, v2;
@@ -556,7 +1171,7 @@ void ConstructVC()
 
     uncov_stack_fill_pointer = 0;
     c_size = 0;
-    best_weight = (int)(~0U >> 1);
+    best_weight = (llong)(~0ULL >> 1);
     now_weight = 0;
 
     for (e = 0; e < e_num; e++)
@@ -582,72 +1197,235 @@ void ConstructVC()
         }
     }
 
-    int *save_v_in_c = new int[v_num + 1];
-    memcpy(save_v_in_c, v_in_c, sizeof(int) * (v_num + 1));
-    int save_c_size = c_size;
-    llong save_weight = now_weight;
+    // Randomized restarts, split round-robin over the construction threads;
+    // the lightest cover wins, ties going to the lowest restart index
+    int threads = construct_threads > 0 ? construct_threads : max(1, (int)thread::hardware_concurrency());
+    int rounds = construct_rounds * threads;
+    double time_limit = construct_time > 0 ? min(construct_time, cutoff_time) : cutoff_time / 10;
+
+    vector<vector<int>> thread_v_in_c(threads);
+    vector<llong> thread_weight(threads, (llong)(~0ULL >> 1));
+    vector<int> thread_round(threads, rounds);
+
+    auto restarts = [&](int t)
+    {
+        vector<int> scratch_v_in_c(v_num + 1);
+        for (int r = t; r < rounds && TimeElapsed() < time_limit; r += threads)
+        {
+            llong weight = ConstructRandomVC(r, scratch_v_in_c.data());
+            if (weight < thread_weight[t])
+            {
+                thread_weight[t] = weight;
+                thread_round[t] = r;
+                thread_v_in_c[t] = scratch_v_in_c;
+            }
+        }
+    };
+
+    if (threads == 1)
+    {
+        restarts(0);
+    }
+    else
+    {
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++)
+        {
+            pool.push_back(thread(restarts, t));
+        }
+        for (auto &worker : pool)
+        {
+            worker.join();
+        }
+    }
+
+    int best_t = 0;
+    for (int t = 1; t < threads; t++)
+    {
+        if (thread_weight[t] < thread_weight[best_t] ||
+            (thread_weight[t] == thread_weight[best_t] && thread_round[t] < thread_round[best_t]))
+        {
+            best_t = t;
+        }
+    }
+
+    if (thread_weight[best_t] < now_weight)
+    {
+        now_weight = thread_weight[best_t];
+        memcpy(v_in_c, thread_v_in_c[best_t].data(), sizeof(int) * (v_num + 1));
+        c_size = (int)count(v_in_c + 1, v_in_c + v_num + 1, 1);
+    }
+
+    InitCoverScores();
+}
+
+/*
+ * Greedy cover over the edges in random order (shuffled 1024-edge blocks,
+ * shuffled within each block), using a generator seeded by the restart
+ * index so the result does not depend on the thread that runs it.
+ * Write the cover to cover and return its weight
+ */
+llong FastWVC::ConstructRandomVC(int round, int *cover)
+{
+    int v1, v2;
+    double v1dd, v2dd;
+    llong weight = 0;
+    Xoshiro128 round_rng;
+
+    round_rng.Seed(((uint64_t)seed << 32) | (uint32_t)round);
+    fill_n(cover, v_num + 1, 0);
 
-    int times = 50;
     vector<int> blocks(e_num / 1024 + 1);
     for (int i = 0; i < e_num / 1024 + 1; i++)
     {
         blocks[i] = i;
     }
-
-    while (times-- > 0)
+    for (int i = (int)blocks.size() - 1; i > 0; i--)
     {
-        fill_n(v_in_c, v_num + 1, 0);
-        c_size = 0;
-        now_weight = 0;
-        shuffle(blocks.begin(), blocks.end(), default_random_engine(seed));
+        swap(blocks[i], blocks[round_rng.Bounded(i + 1)]);
+    }
 
-        for (auto &block : blocks)
+    vector<int> idx(1024);
+    for (auto &block : blocks)
+    {
+        auto begin = block * 1024;
+        auto end = block == e_num / 1024 ? e_num : begin + 1024;
+        int tmpsize = end - begin;
+        for (int i = begin; i < end; i++)
         {
-            auto begin = block * 1024;
-            auto end = block == e_num / 1024 ? e_num : begin + 1024;
-            int tmpsize = end - begin + 1;
-            vector<int> idx(tmpsize);
-            for (int i = begin; i < end; i++)
-            {
-                idx[i - begin] = i;
-            }
-            while (tmpsize > 0)
+            idx[i - begin] = i;
+        }
+        while (tmpsize > 0)
+        {
+            int i = round_rng.Bounded(tmpsize);
+            Edge e = edge[idx[i]];
+            v1 = e.v1;
+            v2 = e.v2;
+            swap(idx[i], idx[--tmpsize]);
+            if (cover[v1] == 0 && cover[v2] == 0)
             {
-                int i = rand() % tmpsize;
-                Edge e = edge[idx[i]];
-                v1 = e.v1;
-                v2 = e.v2;
-                swap(idx[i], idx[--tmpsize]);
-                if (v_in_c[v1] == 0 && v_in_c[v2] == 0)
+                v1dd = (double)v_degree[v1] / (double)v_weight[v1];
+                v2dd = (double)v_degree[v2] / (double)v_weight[v2];
+                if (v1dd > v2dd)
+                {
+                    cover[v1] = 1;
+                    weight += v_weight[v1];
+                }
+                else
                 {
-                    v1dd = (double)v_degree[v1] / (double)v_weight[v1];
-                    v2dd = (double)v_degree[v2] / (double)v_weight[v2];
-                    if (v1dd > v2dd)
-                    {
-                        v_in_c[v1] = 1;
-                        now_weight += v_weight[v1];
-                    }
-                    else
-                    {
-                        v_in_c[v2] = 1;
-                        now_weight += v_weight[v2];
-                    }
-                    c_size++;
+                    cover[v2] = 1;
+                    weight += v_weight[v2];
                 }
             }
         }
-        if (now_weight < save_weight)
+    }
+    return weight;
+}
+
+int FastWVC::LoadInitialCover(string filename)
+{
+    int v;
+    string token;
+
+    ifstream infile(filename);
+    if (!infile)
+    {
+        return 1;
+    }
+
+    init_v_in_c.assign(v_num + 1, 0);
+    while (getline(infile, token, ','))
+    {
+        stringstream ss(token);
+        while (ss >> v)
+        {
+            if (v >= 1 && v <= v_num)
+            {
+                init_v_in_c[v] = 1;
+            }
+        }
+    }
+    infile.close();
+
+    return 0;
+}
+
+/*
+ * Set the cover to start the search from (0-indexed vertices)
+ */
+void FastWVC::SetInitialCover(const vector<bool> &cover)
+{
+    int v;
+
+    init_v_in_c.assign(v_num + 1, 0);
+    for (v = 1; v < v_num + 1 && v <= (int)cover.size(); v++)
+    {
+        init_v_in_c[v] = cover[v - 1] ? 1 : 0;
+    }
+}
+
+/*
+ * Warm start: repair the initial cover by adding, for every edge it
+ * leaves uncovered, the endpoint ConstructVC would pick; the redundant
+ * vertices are then dropped when the search state is rebuilt
+ */
+void FastWVC::ConstructVCFromCover()
+{
+    int e;
+    int v1, v2;
+    double v1dd, v2dd;
+    vector<int> cover(init_v_in_c);
+
+    for (e = 0; e < e_num; e++)
+    {
+        v1 = edge[e].v1;
+        v2 = edge[e].v2;
+
+        if (cover[v1] == 0 && cover[v2] == 0)
+        {
+            v1dd = (double)v_degree[v1] / (double)v_weight[v1];
+            v2dd = (double)v_degree[v2] / (double)v_weight[v2];
+            cover[v1dd > v2dd ? v1 : v2] = 1;
+        }
+    }
+
+    ResetToCover(cover.data());
+}
+
+/*
+ * Rebuild the search state around a complete cover,
+ * keeping the current edge weights
+ */
+void FastWVC::ResetToCover(const int *cover)
+{
+    int v;
+
+    uncov_stack_fill_pointer = 0;
+    c_size = 0;
+    now_weight = 0;
+    fill_n(dscore, v_num + 1, 0);
+
+    for (v = 1; v < v_num + 1; v++)
+    {
+        if (v_in_c[v] != cover[v])
+        {
+            JournalChange(v);
+        }
+        v_in_c[v] = cover[v];
+        if (v_in_c[v] == 1)
         {
-            save_weight = now_weight;
-            save_c_size = c_size;
-            memcpy(save_v_in_c, v_in_c, sizeof(int) * (v_num + 1));
+            now_weight += v_weight[v];
+            c_size++;
         }
     }
 
-    now_weight = save_weight;
-    c_size = save_c_size;
-    memcpy(v_in_c, save_v_in_c, sizeof(int) * (v_num + 1));
-    delete[] save_v_in_c;
+    InitCoverScores();
+}
+
+void FastWVC::InitCoverScores()
+{
+    int e;
+    int v1, v2;
 
     for (e = 0; e < e_num; e++)
     {
@@ -675,35 +1453,422 @@ void ConstructVC()
     UpdateBestSolution();
 }
 
-int CheckSolution()
+/*
+ * Run the search from the (repaired) initial cover if one was given,
+ * otherwise from a constructed one, or continue the search of a loaded
+ * checkpoint. Return 0 if the best cover is valid
+ */
+int FastWVC::Solve()
+{
+    bool resumed = resume;
+
+    start = chrono::steady_clock::now();
+    resume = false;
+#ifdef FASTWVC_STATS
+    stats = SearchStats();
+#endif
+
+    if (resumed)
+    {
+        // Count the time already spent towards the cutoff
+        start -= chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(resume_elapsed));
+        mode = resume_mode;
+        if (shared != 0)
+        {
+            PublishBestSolution();
+        }
+    }
+    else
+    {
+        rng.Seed(seed);
+        step = 0;
+        restart_step = 0;
+        best_weight = (llong)(~0ULL >> 1);
+
+        // Start from an empty cover and unit edge weights on every call
+        fill_n(v_in_c, v_num + 1, 0);
+        fill_n(dscore, v_num + 1, 0);
+        fill_n(conf_change, v_num + 1, 1);
+        fill_n(time_stamp, v_num + 1, 0);
+        fill_n(in_best_journal, v_num + 1, 0);
+        best_journal_fill_pointer = 0;
+        fill_n(edge_weight, e_num, 1);
+
+        STATS_TIME(construct);
+        if (init_v_in_c.empty())
+        {
+            ConstructVC();
+        }
+        else
+        {
+            ConstructVCFromCover();
+        }
+    }
+
+    if (e_num > 0 && !GapClosed())
+    {
+        if (!resumed)
+        {
+            InitLocalSearch();
+        }
+        last_checkpoint = TimeElapsed();
+        {
+            STATS_TIME(search);
+            LocalSearch();
+        }
+        STATS_COUNT(search_seconds, TimeElapsed() - last_checkpoint);
+
+        // The search stops between steps, with every edge covered
+        if (!checkpoint_file.empty() && uncov_stack_fill_pointer == 0)
+        {
+            SaveCheckpoint(checkpoint_file);
+        }
+    }
+    stop_requested = false;
+
+#ifdef FASTWVC_STATS
+    PrintStats();
+#endif
+
+    return CheckSolution() == 1 ? 0 : 1;
+}
+
+#ifdef FASTWVC_STATS
+/*
+ * Summary of the last Solve() on stderr, in one write so the workers of a
+ * portfolio do not interleave
+ */
+void FastWVC::PrintStats() const
+{
+    ostringstream out;
+    double ticks = max<double>(1.0, (double)stats.search_ticks);
+    const pair<const char *, uint64_t> sections[] = {
+        {"UpdateTargetSize", stats.target_size_ticks},
+        {"ChooseRemoveV", stats.choose_remove_ticks},
+        {"ChooseAddV", stats.choose_add_ticks},
+        {"Add", stats.add_ticks},
+        {"Remove", stats.remove_ticks},
+        {"UpdateEdgeWeight", stats.update_weight_ticks},
+        {"ForgetEdgeWeights", stats.forget_ticks},
+        {"RescaleEdgeWeights", stats.rescale_ticks}};
+
+    out << fixed << setprecision(1);
+    out << "FastWVC stats (seed " << seed << ", mode " << mode << "): "
+        << stats.steps << " steps in " << stats.search_seconds << " s ("
+        << (llong)(stats.search_seconds > 0 ? stats.steps / stats.search_seconds : 0.0) << " steps/s)" << endl;
+    out << "  adds " << stats.adds << ", removes " << stats.removes
+        << ", improvements " << stats.improvements << ", restarts " << stats.restarts
+        << ", forgets " << stats.forgets << ", rescales " << stats.rescales << endl;
+    out << "  ChooseAddV scans " << stats.add_scans << " vertices ("
+        << (stats.adds > 0 ? (double)stats.add_scans / stats.adds : 0.0) << " per add)" << endl;
+    out << "  " STATS_TICK_UNIT ": construction " << stats.construct_ticks << ", search " << stats.search_ticks << endl;
+    for (const auto &section : sections)
+    {
+        out << "    " << setw(18) << left << section.first << right << setw(16) << section.second
+            << setw(7) << 100.0 * section.second / ticks << "%" << endl;
+    }
+    cerr << out.str();
+}
+#endif
+
+/*
+ * Copy the best cover found into cover (0-indexed vertices)
+ */
+void FastWVC::GetBestCover(vector<bool> &cover) const
+{
+    int v;
+
+    cover.assign(v_num, false);
+    for (v = 1; v < v_num + 1; v++)
+    {
+        cover[v - 1] = BestInCover(v) == 1;
+    }
+}
+
+int FastWVC::CheckSolution()
 {
     int e;
 
     for (e = 0; e < e_num; ++e)
     {
-        if (best_v_in_c[edge[e].v1] != 1 && best_v_in_c[edge[e].v2] != 1)
+        if (BestInCover(edge[e].v1) != 1 && BestInCover(edge[e].v2) != 1)
         {
-            cout << ", uncovered edge " << e;
+            cerr << "Uncovered edge " << e << endl;
             return 0;
         }
     }
     return 1;
 }
 
-void ForgetEdgeWeights()
+template <class T>
+void FastWVC::WriteValues(ofstream &out, const T *values, size_t count)
+{
+    out.write((const char *)values, sizeof(T) * count);
+}
+
+template <class T>
+void FastWVC::ReadValues(ifstream &in, T *values, size_t count)
+{
+    in.read((char *)values, sizeof(T) * count);
+}
+
+/*
+ * FNV-1a hash of the vertex weights and edges, so a checkpoint is only
+ * resumed on the instance it was taken on
+ */
+uint64_t FastWVC::InstanceFingerprint() const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    int v, e;
+
+    for (v = 1; v < v_num + 1; v++)
+    {
+        hash = (hash ^ (uint32_t)v_weight[v]) * 0x100000001b3ULL;
+    }
+    for (e = 0; e < e_num; e++)
+    {
+        hash = (hash ^ (uint32_t)edge[e].v1) * 0x100000001b3ULL;
+        hash = (hash ^ (uint32_t)edge[e].v2) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/*
+ * Write the search state between two steps to filename: the current and
+ * best covers, edge weights, scores, tabu and age stamps, the remove_cand
+ * heap, the random generator and the step, time and forgetting counters.
+ * The file is written aside and renamed over the previous checkpoint, so
+ * an interrupted write keeps it. Return 0 on success
+ */
+int FastWVC::SaveCheckpoint(string filename)
+{
+    int v;
+    string tmp_filename = filename + ".tmp";
+    ofstream out(tmp_filename, ios::binary);
+    if (!out)
+    {
+        return 1;
+    }
+
+    int sizes[4] = {v_num, e_num, (int)sizeof(eweight), mode};
+    uint64_t fingerprint = InstanceFingerprint();
+    llong steps[4] = {step, best_step, restart_step, best_weight};
+    double times[4] = {TimeElapsed(), best_comp_time, p_scale, exact_unit};
+    int counters[7] = {best_c_size, ave_weight, delta_total_weight, threshold,
+                       weight_unit, max_edge_weight, edge_weight_limit};
+
+    out.write("FWVCCKP2", 8);
+    WriteValues(out, sizes, 4);
+    WriteValues(out, &fingerprint, 1);
+    WriteValues(out, steps, 4);
+    WriteValues(out, times, 4);
+    WriteValues(out, counters, 7);
+    WriteValues(out, rng.state, 4);
+
+    // Covers and configuration flags as one byte per vertex
+    vector<char> flags(3 * (v_num + 1));
+    for (v = 0; v < v_num + 1; v++)
+    {
+        flags[v] = (char)v_in_c[v];
+        flags[v_num + 1 + v] = (char)BestInCover(v);
+        flags[2 * (v_num + 1) + v] = (char)conf_change[v];
+    }
+    WriteValues(out, flags.data(), flags.size());
+    WriteValues(out, dscore, v_num + 1);
+    WriteValues(out, tabu_list, v_num + 1);
+    WriteValues(out, time_stamp, v_num + 1);
+    WriteValues(out, edge_weight, e_num);
+    WriteValues(out, &remove_cand_size, 1);
+    WriteValues(out, remove_cand, remove_cand_size);
+
+    out.close();
+    if (!out || rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Load a checkpoint saved on this instance, so that the next Solve()
+ * continues its search (in its CC mode) instead of starting over; the
+ * time it had run counts towards the cutoff. Return 0 on success, 1 if
+ * the file is missing, truncated, corrupt or from another instance or build
+ */
+int FastWVC::LoadCheckpoint(string filename)
+{
+    int v;
+    char magic[8];
+
+    resume = false;
+    ifstream in(filename, ios::binary);
+    if (!in)
+    {
+        return 1;
+    }
+
+    int sizes[4];
+    uint64_t fingerprint;
+    in.read(magic, 8);
+    ReadValues(in, sizes, 4);
+    ReadValues(in, &fingerprint, 1);
+    if (!in || memcmp(magic, "FWVCCKP2", 8) != 0 || sizes[0] != v_num || sizes[1] != e_num ||
+        sizes[2] != (int)sizeof(eweight) || fingerprint != InstanceFingerprint())
+    {
+        return 1;
+    }
+
+    llong steps[4];
+    double times[4];
+    int counters[7];
+    ReadValues(in, steps, 4);
+    ReadValues(in, times, 4);
+    ReadValues(in, counters, 7);
+    ReadValues(in, rng.state, 4);
+
+    vector<char> flags(3 * (v_num + 1));
+    ReadValues(in, flags.data(), flags.size());
+    ReadValues(in, dscore, v_num + 1);
+    ReadValues(in, tabu_list, v_num + 1);
+    ReadValues(in, time_stamp, v_num + 1);
+    ReadValues(in, edge_weight, e_num);
+    ReadValues(in, &remove_cand_size, 1);
+    if (!in || remove_cand_size < 0 || remove_cand_size > v_num)
+    {
+        return 1;
+    }
+    ReadValues(in, remove_cand, remove_cand_size);
+
+    // The body is used for indexing: reject anything but the exact layout
+    // with 0/1 flags (none on vertex 0) and remove_cand holding exactly
+    // the cover vertices. Solve() rebuilds whatever was read on failure
+    if (!in || in.peek() != EOF || flags[0] != 0 || flags[v_num + 1] != 0 ||
+        sizes[3] < 0 || sizes[3] > 3 || counters[4] < 1 ||
+        !(times[3] >= 0.5 && times[3] < counters[4] + 0.5))
+    {
+        return 1;
+    }
+    int cover_size = 0;
+    for (v = 0; v < (int)flags.size(); v++)
+    {
+        if (flags[v] != 0 && flags[v] != 1)
+        {
+            return 1;
+        }
+        cover_size += v <= v_num ? flags[v] : 0;
+    }
+    if (remove_cand_size != cover_size)
+    {
+        return 1;
+    }
+    fill_n(index_in_remove_cand, v_num + 1, -1);
+    for (v = 0; v < remove_cand_size; v++)
+    {
+        int u = remove_cand[v];
+        if (u < 1 || u > v_num || flags[u] != 1 || index_in_remove_cand[u] != -1)
+        {
+            return 1;
+        }
+        index_in_remove_cand[u] = v;
+    }
+
+    resume_mode = sizes[3];
+    step = steps[0];
+    best_step = steps[1];
+    restart_step = steps[2];
+    best_weight = steps[3];
+    resume_elapsed = times[0];
+    best_comp_time = times[1];
+    p_scale = times[2];
+    exact_unit = times[3];
+    best_c_size = counters[0];
+    ave_weight = counters[1];
+    delta_total_weight = counters[2];
+    threshold = counters[3];
+    weight_unit = counters[4];
+    max_edge_weight = counters[5];
+    edge_weight_limit = counters[6];
+    try_step = 100;
+
+    // Rebuild the cover, its weight and the best cover journal
+    c_size = 0;
+    now_weight = 0;
+    best_journal_fill_pointer = 0;
+    uncov_stack_fill_pointer = 0;
+    for (v = 0; v < v_num + 1; v++)
+    {
+        v_in_c[v] = flags[v];
+        conf_change[v] = flags[2 * (v_num + 1) + v];
+        in_best_journal[v] = 0;
+        if (index_in_remove_cand[v] == -1)
+        {
+            index_in_remove_cand[v] = 0;
+        }
+        if (v_in_c[v] == 1)
+        {
+            c_size++;
+            now_weight += v_weight[v];
+        }
+        if (flags[v_num + 1 + v] != v_in_c[v])
+        {
+            JournalChange(v);
+            best_v_in_c[v] = flags[v_num + 1 + v];
+        }
+    }
+
+    resume = true;
+    return 0;
+}
+
+/*
+ * Scale the real edge weights by p_scale. Stored weights stay as they are
+ * and later increments grow by 1 / p_scale instead, which keeps every
+ * weight positive and every dscore ratio unchanged. The increment is
+ * rounded to an integer, so a single forget scales by weight_unit over
+ * the new unit (1/3 rather than 0.3 on the first one after a rescale),
+ * but the unit tracks the exact product of the scales and does not drift
+ */
+void FastWVC::ForgetEdgeWeights()
+{
+    STATS_TIME(forget);
+    STATS_COUNT(forgets, 1);
+    ave_weight = (int)(ave_weight * p_scale);
+
+    if (exact_unit / p_scale > edge_weight_limit)
+    {
+        RescaleEdgeWeights();
+    }
+    exact_unit /= p_scale;
+    weight_unit = (int)(exact_unit + 0.5);
+}
+
+/*
+ * Divide the stored edge weights by weight_unit, or halve the real weights
+ * if the unit is already 1 (keeping them positive), and recompute dscore;
+ * only needed before stored weights could overflow
+ */
+void FastWVC::RescaleEdgeWeights()
 {
     int v, e;
-    int new_total_weitght = 0;
+    int divisor = weight_unit > 1 ? weight_unit : 2;
+    STATS_TIME(rescale);
+    STATS_COUNT(rescales, 1);
+
+    if (weight_unit == 1)
+    {
+        ave_weight = max(1, ave_weight / 2);
+    }
 
     for (v = 1; v < v_num + 1; v++)
     {
         dscore[v] = 0;
     }
 
+    max_edge_weight = 1;
     for (e = 0; e < e_num; e++)
     {
-        edge_weight[e] = edge_weight[e] * p_scale;
-        new_total_weitght += edge_weight[e];
+        edge_weight[e] = max(1, edge_weight[e] / divisor);
+        max_edge_weight = max(max_edge_weight, (int)edge_weight[e]);
 
         if (v_in_c[edge[e].v1] + v_in_c[edge[e].v2] == 0)
         {
@@ -722,20 +1887,29 @@ void ForgetEdgeWeights()
             }
         }
     }
-    ave_weight = new_total_weitght / e_num;
+    weight_unit = 1;
+    exact_unit = 1.0;
+
+    ResetRemoveCand();
 }
 
-void UpdateEdgeWeight()
+template <int cc_mode>
+void FastWVC::UpdateEdgeWeight()
 {
     int i, e;
+    STATS_TIME(update_weight);
 
     for (i = 0; i < uncov_stack_fill_pointer; i++)
     {
         e = uncov_stack[i];
-        edge_weight[e] += 1;
-        dscore[edge[e].v1] += 1;
-        dscore[edge[e].v2] += 1;
-        if (mode % 2 == 1)
+        edge_weight[e] += weight_unit;
+        dscore[edge[e].v1] += weight_unit;
+        dscore[edge[e].v2] += weight_unit;
+        if (edge_weight[e] > max_edge_weight)
+        {
+            max_edge_weight = edge_weight[e];
+        }
+        if (WeightCC<cc_mode>())
         {
             conf_change[edge[e].v1] = 1;
             conf_change[edge[e].v2] = 1;
@@ -744,7 +1918,7 @@ void UpdateEdgeWeight()
 
     delta_total_weight += uncov_stack_fill_pointer;
 
-    if (mode / 2 == 1)
+    if (Forgetting<cc_mode>())
     {
         if (delta_total_weight >= e_num)
         {
@@ -757,11 +1931,44 @@ void UpdateEdgeWeight()
             ForgetEdgeWeights();
         }
     }
+
+    if (max_edge_weight > edge_weight_limit)
+    {
+        RescaleEdgeWeights();
+    }
 }
 
-void LocalSearch()
+/*
+ * Run the search specialized for the CC mode
+ * (or the generic one, if specialize_search is off)
+ */
+void FastWVC::LocalSearch()
+{
+    if (!specialize_search)
+    {
+        LocalSearch<-1>();
+        return;
+    }
+
+    switch (mode)
+    {
+    case 1:
+        LocalSearch<1>();
+        break;
+    case 2:
+        LocalSearch<2>();
+        break;
+    case 3:
+        LocalSearch<3>();
+        break;
+    default:
+        LocalSearch<0>();
+        break;
+    }
+}
+
+void FastWVC::InitLocalSearch()
 {
-    int add_v, remove_v, update_v = 0;
     step = 1;
     try_step = 100;
 
@@ -770,18 +1977,63 @@ void LocalSearch()
     p_scale = 0.3;
     threshold = (int)(0.5 * v_num);
 
+    // Keep every stored weight (at most twice the limit) within eweight
+    // and every dscore (a sum of at most max degree of them) within int
+    weight_unit = 1;
+    exact_unit = 1.0;
+    max_edge_weight = e_num > 0 ? *max_element(edge_weight, edge_weight + e_num) : 1;
+    edge_weight_limit = min(INT_MAX / (2 * (*max_element(v_degree + 1, v_degree + v_num + 1) + 1)),
+                            (int)(numeric_limits<eweight>::max() / 2));
+
+    fill_n(tabu_list, v_num + 1, 0);
+}
+
+template <int cc_mode>
+void FastWVC::LocalSearch()
+{
+    int add_v, remove_v, update_v = 0;
+
     while (true)
     {
         UpdateBestSolution();
-        update_v = UpdateTargetSize();
+        if (stop_requested.load(memory_order_relaxed) || GapClosed())
+        {
+            return;
+        }
+        if ((max_steps > 0 && step > max_steps) || (stall_steps > 0 && step - best_step > stall_steps))
+        {
+            return;
+        }
 
         if (step % try_step == 0)
         {
-            if (TimeElapsed() >= cutoff_time)
+            double elapsed = TimeElapsed();
+            if (elapsed >= cutoff_time)
             {
                 return;
             }
+
+            // Another worker reached the target gap
+            if (shared != 0 && GapOf(shared->best_weight.load(memory_order_relaxed), lower_bound) <= target_gap)
+            {
+                return;
+            }
+
+            // Lagging behind the portfolio for too long
+            if (shared != 0 && step - restart_step >= restart_steps &&
+                best_weight > shared->best_weight.load(memory_order_relaxed))
+            {
+                RestartFromIncumbent();
+            }
+
+            if (!checkpoint_file.empty() && checkpoint_interval > 0 &&
+                elapsed - last_checkpoint >= checkpoint_interval)
+            {
+                SaveCheckpoint(checkpoint_file);
+                last_checkpoint = elapsed;
+            }
         }
+        update_v = UpdateTargetSize();
 
         /* Added by Gordon Su from advice by Rillo Orazio:
          * Check for and return if the set of candidates for the elimination
@@ -795,18 +2047,256 @@ void LocalSearch()
         Remove(remove_v);
         time_stamp[remove_v] = step;
 
-        fill_n(tabu_list, v_num + 1, 0);
-
         while (uncov_stack_fill_pointer > 0)
         {
             add_v = ChooseAddV(remove_v, update_v);
             Add(add_v);
-            UpdateEdgeWeight();
-            tabu_list[add_v] = 1;
+            UpdateEdgeWeight<cc_mode>();
+            tabu_list[add_v] = (int)(step + 1);
             time_stamp[add_v] = step;
         }
         RemoveRedundant();
         step++;
         update_v = 0;
+        STATS_COUNT(steps, 1);
+    }
+}
+
+bool FastWVC::GapClosed() const
+{
+    return GapOf(best_weight, lower_bound) <= target_gap;
+}
+
+/*
+ * Portfolio of FastWVC workers searching the same instance in parallel,
+ * with different seeds and CC modes and a shared best cover
+ */
+class FastWVCPortfolio
+{
+public:
+    uint    seed;
+    double  cutoff_time;    // seconds
+    int     mode;
+    int     num_threads;
+    llong   max_steps;
+    llong   stall_steps;
+    int     construct_threads;
+    int     construct_rounds;
+    double  construct_time;
+    bool    huge_pages;
+    llong   restart_steps;
+    ImprovementCallback on_improvement;
+    llong   lower_bound;
+    double  target_gap;
+    // Checkpoints of worker i go to checkpoint_file + "." + i with more
+    // than one thread
+    string  checkpoint_file;
+    double  checkpoint_interval;
+
+    FastWVCPortfolio(int);
+
+    int BuildInstance(string);
+    int BuildInstance(int, const int *, const int *, const int *);
+    void GetInstance(vector<int> &w, vector<int> &r, vector<int> &c) const { workers[0]->GetInstance(w, r, c); }
+    int LoadInitialCover(string);
+    void SetInitialCover(const vector<bool> &);
+    int LoadCheckpoint(string);
+    int Solve();
+    void Stop();
+
+    int VertexCount() const { return workers[0]->VertexCount(); }
+    llong BestWeight() const { return best_weight; }
+    double BestCompTime() const { return best_comp_time; }
+    double Gap() const { return FastWVC::GapOf(best_weight, lower_bound); }
+    void GetBestCover(vector<bool> &) const;
+
+private:
+    vector<unique_ptr<FastWVC>> workers;
+    SharedIncumbent incumbent;
+    llong   best_weight;
+    double  best_comp_time;
+    int     best_worker;
+
+    string WorkerCheckpoint(string, int) const;
+};
+
+FastWVCPortfolio::FastWVCPortfolio(int threads)
+{
+    int i;
+
+    seed = 0;
+    cutoff_time = 1;
+    mode = 0;
+    max_steps = 0;
+    stall_steps = 0;
+    construct_threads = 1;
+    construct_rounds = 50;
+    construct_time = 0.0;
+    huge_pages = false;
+    num_threads = threads < 1 ? 1 : threads;
+    restart_steps = 50000;
+    lower_bound = 0;
+    target_gap = 0.0;
+    checkpoint_interval = 60.0;
+    best_weight = 0;
+    best_comp_time = 0.0;
+    best_worker = 0;
+
+    for (i = 0; i < num_threads; i++)
+    {
+        workers.push_back(unique_ptr<FastWVC>(new FastWVC()));
+    }
+}
+
+int FastWVCPortfolio::BuildInstance(string filename)
+{
+    for (auto &worker : workers)
+    {
+        worker->huge_pages = huge_pages;
+        if (worker->BuildInstance(filename) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int FastWVCPortfolio::BuildInstance(int num_vertices, const int *weights, const int *row_offsets, const int *col_indices)
+{
+    for (auto &worker : workers)
+    {
+        worker->huge_pages = huge_pages;
+        worker->BuildInstance(num_vertices, weights, row_offsets, col_indices);
+    }
+    return 0;
+}
+
+int FastWVCPortfolio::LoadInitialCover(string filename)
+{
+    for (auto &worker : workers)
+    {
+        if (worker->LoadInitialCover(filename) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void FastWVCPortfolio::SetInitialCover(const vector<bool> &cover)
+{
+    for (auto &worker : workers)
+    {
+        worker->SetInitialCover(cover);
+    }
+}
+
+string FastWVCPortfolio::WorkerCheckpoint(string filename, int worker) const
+{
+    return num_threads > 1 ? filename + "." + to_string(worker) : filename;
+}
+
+/*
+ * Resume every worker from its checkpoint (saved with the same number of
+ * threads). Return 0 if all of them were loaded; the others start over
+ */
+int FastWVCPortfolio::LoadCheckpoint(string filename)
+{
+    int result = 0;
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        if (workers[i]->LoadCheckpoint(WorkerCheckpoint(filename, i)) != 0)
+        {
+            result = 1;
+        }
+    }
+    return result;
+}
+
+/*
+ * Run every worker in its own thread (worker 0 with the configured seed
+ * and CC mode, the others with shifted seeds and rotating modes).
+ * Return 0 if the best cover is valid
+ */
+int FastWVCPortfolio::Solve()
+{
+    int i;
+    vector<thread> threads;
+
+    incumbent.best_weight = (llong)(~0ULL >> 1);
+    incumbent.best_v_in_c.clear();
+    incumbent.on_improvement = on_improvement;
+
+    for (i = 0; i < num_threads; i++)
+    {
+        FastWVC *worker = workers[i].get();
+        worker->seed = seed + i;
+        worker->cutoff_time = cutoff_time;
+        worker->max_steps = max_steps;
+        worker->stall_steps = stall_steps;
+        worker->construct_threads = construct_threads;
+        worker->construct_rounds = construct_rounds;
+        worker->construct_time = construct_time;
+        worker->mode = (mode + i) % 4;
+        worker->restart_steps = restart_steps;
+        worker->lower_bound = lower_bound;
+        worker->target_gap = target_gap;
+        worker->checkpoint_file = checkpoint_file.empty() ? "" : WorkerCheckpoint(checkpoint_file, i);
+        worker->checkpoint_interval = checkpoint_interval;
+        worker->shared = num_threads > 1 ? &incumbent : 0;
+        // Improvements of several workers are reported through the incumbent
+        worker->on_improvement = num_threads > 1 ? ImprovementCallback() : on_improvement;
+    }
+
+    if (num_threads == 1)
+    {
+        best_worker = 0;
+        int result = workers[0]->Solve();
+        best_weight = workers[0]->BestWeight();
+        best_comp_time = workers[0]->BestCompTime();
+        return result;
+    }
+
+    for (i = 0; i < num_threads; i++)
+    {
+        threads.push_back(thread([this, i]() { workers[i]->Solve(); }));
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    // The worker holding the shared best cover found it first or restarted onto it
+    best_worker = 0;
+    for (i = 1; i < num_threads; i++)
+    {
+        if (workers[i]->BestWeight() < workers[best_worker]->BestWeight())
+        {
+            best_worker = i;
+        }
     }
+    best_weight = workers[best_worker]->BestWeight();
+    best_comp_time = incumbent.best_comp_time;
+
+    return workers[best_worker]->CheckSolution() == 1 ? 0 : 1;
 }
+
+void FastWVCPortfolio::Stop()
+{
+    for (auto &worker : workers)
+    {
+        worker->Stop();
+    }
+}
+
+void FastWVCPortfolio::GetBestCover(vector<bool> &cover) const
+{
+    workers[best_worker]->GetBestCover(cover);
+}
+
+#undef pop
+#undef push
+#undef PREFETCH_DISTANCE
+#undef STATS_COUNT
+#undef STATS_TIME
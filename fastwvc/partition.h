@@ -0,0 +1,435 @@
+#pragma once
+
+#include "mwvc.h"
+
+/*
+ * Partition-parallel local search for a single large instance: the graph is
+ * split into one BFS-grown region per thread, one endpoint of every edge
+ * between regions is frozen in the cover, and each thread runs FastWVC on
+ * the rest of its region (warm-started from the current cover). The region
+ * covers plus the frozen vertices form a cover of the whole graph, kept if
+ * no worse; the graph is then re-partitioned around other seeds, so the
+ * frozen boundaries move from round to round.
+ *
+ * Regions do not coordinate moves across their boundary: a frozen vertex
+ * stays in the cover for the whole round, so a boundary edge can only be
+ * improved in a later round that puts both endpoints in one region. Each
+ * thread keeps its FastWVC instance (and its arena) across rounds
+ */
+class FastWVCPartitioned
+{
+public:
+    uint    seed;
+    double  cutoff_time;    // seconds
+    double  round_time;     // seconds per partitioning round (0 to derive it from the cutoff)
+    int     mode;
+    int     num_threads;
+
+    FastWVCPartitioned(int);
+
+    int BuildInstance(int, const int *, const int *, const int *);
+    void SetInitialCover(const vector<bool> &);
+    int Solve();
+
+    int VertexCount() const { return v_num; }
+    llong BestWeight() const { return best_weight; }
+    double BestCompTime() const { return best_comp_time; }
+    llong StepCount() const { return total_steps; }
+    void GetBestCover(vector<bool> &) const;
+    int CheckSolution() const;
+
+private:
+    int         v_num;
+    vector<int> weights;
+    vector<int> row_offsets;
+    vector<int> col_indices;
+
+    vector<int> region;     // region of each vertex
+    vector<char> frozen;    // kept in the cover this round
+    vector<vector<int>> members;    // free vertices of each region
+    vector<int> local_of;   // index of a free vertex within its region
+    vector<char> in_cover;  // current cover (empty before the first round)
+
+    // Per-region buffers and solvers, reused from round to round
+    vector<vector<int>> frontier;
+    vector<vector<int>> local_weights;
+    vector<vector<int>> local_offsets;
+    vector<vector<int>> local_indices;
+    vector<unique_ptr<FastWVC>> solvers;
+
+    Xoshiro128 rng;
+    llong   best_weight;
+    double  best_comp_time;
+    llong   total_steps;
+
+    void Partition(int);
+    void FreezeBoundary();
+    void SolveRegion(int, uint, double, vector<int> &, llong &, llong &);
+    llong CoverWeight(const vector<char> &) const;
+};
+
+FastWVCPartitioned::FastWVCPartitioned(int threads)
+{
+    seed = 0;
+    cutoff_time = 1;
+    round_time = 0.0;
+    mode = 0;
+    num_threads = threads < 1 ? 1 : threads;
+    v_num = 0;
+    best_weight = 0;
+    best_comp_time = 0.0;
+    total_steps = 0;
+}
+
+int FastWVCPartitioned::BuildInstance(int num_vertices, const int *vertex_weights, const int *offsets, const int *indices)
+{
+    v_num = num_vertices;
+    weights.assign(vertex_weights, vertex_weights + num_vertices);
+    row_offsets.assign(offsets, offsets + num_vertices + 1);
+    col_indices.assign(indices, indices + offsets[num_vertices]);
+    in_cover.clear();
+    return 0;
+}
+
+void FastWVCPartitioned::SetInitialCover(const vector<bool> &cover)
+{
+    in_cover.assign(v_num, 0);
+    for (int v = 0; v < v_num && v < (int)cover.size(); v++)
+    {
+        in_cover[v] = cover[v] ? 1 : 0;
+    }
+}
+
+void FastWVCPartitioned::GetBestCover(vector<bool> &cover) const
+{
+    cover.assign(v_num, false);
+    for (int v = 0; v < (int)in_cover.size(); v++)
+    {
+        cover[v] = in_cover[v] == 1;
+    }
+}
+
+int FastWVCPartitioned::CheckSolution() const
+{
+    int u, i;
+
+    if ((int)in_cover.size() != v_num)
+    {
+        return 0;
+    }
+    for (u = 0; u < v_num; u++)
+    {
+        for (i = row_offsets[u]; i < row_offsets[u + 1]; i++)
+        {
+            if (in_cover[u] == 0 && in_cover[col_indices[i]] == 0)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+llong FastWVCPartitioned::CoverWeight(const vector<char> &cover) const
+{
+    llong weight = 0;
+    for (int v = 0; v < v_num; v++)
+    {
+        weight += cover[v] == 1 ? weights[v] : 0;
+    }
+    return weight;
+}
+
+/*
+ * Grow the regions breadth-first from random seed vertices, one vertex per
+ * region in turn so they stay balanced; vertices left unreached (in other
+ * components) start over in the smallest region
+ */
+void FastWVCPartitioned::Partition(int regions)
+{
+    int r, v;
+    vector<vector<int>> &queue = frontier;
+    vector<int> head(regions, 0);
+    vector<int> size(regions, 0);
+
+    region.assign(v_num, -1);
+    queue.resize(regions);
+    for (r = 0; r < regions; r++)
+    {
+        queue[r].clear();
+        v = rng.Bounded(v_num);
+        if (region[v] == -1)
+        {
+            region[v] = r;
+            queue[r].push_back(v);
+            size[r]++;
+        }
+    }
+
+    // Position in the adjacency of each region's oldest frontier vertex
+    vector<int> cursor(regions, -1);
+    int next_unassigned = 0;
+    bool growing = true;
+    while (growing)
+    {
+        growing = false;
+        for (r = 0; r < regions; r++)
+        {
+            // Claim the next unassigned neighbor of the oldest frontier vertex
+            while (head[r] < (int)queue[r].size())
+            {
+                int u = queue[r][head[r]];
+                if (cursor[r] == -1)
+                {
+                    cursor[r] = row_offsets[u];
+                }
+                while (cursor[r] < row_offsets[u + 1] && region[col_indices[cursor[r]]] != -1)
+                {
+                    cursor[r]++;
+                }
+                if (cursor[r] == row_offsets[u + 1])
+                {
+                    head[r]++;
+                    cursor[r] = -1;
+                    continue;
+                }
+                v = col_indices[cursor[r]];
+                region[v] = r;
+                queue[r].push_back(v);
+                size[r]++;
+                growing = true;
+                break;
+            }
+        }
+
+        if (!growing)
+        {
+            while (next_unassigned < v_num && region[next_unassigned] != -1)
+            {
+                next_unassigned++;
+            }
+            if (next_unassigned < v_num)
+            {
+                r = (int)(min_element(size.begin(), size.end()) - size.begin());
+                region[next_unassigned] = r;
+                queue[r].push_back(next_unassigned);
+                size[r]++;
+                growing = true;
+            }
+        }
+    }
+}
+
+/*
+ * Freeze one endpoint of every edge between regions: the one in the current
+ * cover (the lighter one if both are), or before the first cover the one
+ * ConstructVC would pick
+ */
+void FastWVCPartitioned::FreezeBoundary()
+{
+    int u, x, i;
+
+    frozen.assign(v_num, 0);
+    for (u = 0; u < v_num; u++)
+    {
+        for (i = row_offsets[u]; i < row_offsets[u + 1]; i++)
+        {
+            x = col_indices[i];
+            if (u > x || region[u] == region[x] || frozen[u] == 1 || frozen[x] == 1)
+            {
+                continue;
+            }
+
+            bool keep_u;
+            if (!in_cover.empty() && in_cover[u] != in_cover[x])
+            {
+                keep_u = in_cover[u] == 1;
+            }
+            else if (!in_cover.empty())
+            {
+                keep_u = weights[u] <= weights[x];
+            }
+            else
+            {
+                keep_u = (double)(row_offsets[u + 1] - row_offsets[u]) / weights[u] >
+                         (double)(row_offsets[x + 1] - row_offsets[x]) / weights[x];
+            }
+            frozen[keep_u ? u : x] = 1;
+        }
+    }
+}
+
+/*
+ * Solve the MWVC of region r without its frozen vertices, warm-started from
+ * the current cover, on the region's own solver; return its cover
+ * (vertex ids), weight and step count
+ */
+void FastWVCPartitioned::SolveRegion(int r, uint worker_seed, double time_limit, vector<int> &cover, llong &weight, llong &steps)
+{
+    const vector<int> &vertices = members[r];
+    int n = (int)vertices.size();
+    int u, x, i, k;
+
+    cover.clear();
+    weight = 0;
+    steps = 0;
+    if (n == 0)
+    {
+        return;
+    }
+
+    // Local CSR keeping only the edges between free vertices of the region
+    vector<int> &region_weights = local_weights[r];
+    vector<int> &region_offsets = local_offsets[r];
+    vector<int> &region_indices = local_indices[r];
+    region_weights.resize(n);
+    region_offsets.assign(n + 1, 0);
+    region_indices.clear();
+    for (i = 0; i < n; i++)
+    {
+        u = vertices[i];
+        region_weights[i] = weights[u];
+        for (k = row_offsets[u]; k < row_offsets[u + 1]; k++)
+        {
+            x = col_indices[k];
+            if (region[x] == r && frozen[x] == 0)
+            {
+                region_indices.push_back(local_of[x]);
+            }
+        }
+        region_offsets[i + 1] = (int)region_indices.size();
+    }
+
+    FastWVC &solver = *solvers[r];
+    solver.BuildInstance(n, region_weights.data(), region_offsets.data(), region_indices.data());
+    solver.seed = worker_seed;
+    solver.mode = mode;
+    solver.cutoff_time = time_limit;
+
+    if (!in_cover.empty())
+    {
+        vector<bool> warm(n);
+        for (i = 0; i < n; i++)
+        {
+            warm[i] = in_cover[vertices[i]] == 1;
+        }
+        solver.SetInitialCover(warm);
+    }
+
+    solver.Solve();
+
+    vector<bool> local_cover;
+    solver.GetBestCover(local_cover);
+    for (i = 0; i < n; i++)
+    {
+        if (local_cover[i])
+        {
+            cover.push_back(vertices[i]);
+        }
+    }
+    weight = solver.BestWeight();
+    steps = solver.StepCount();
+}
+
+/*
+ * Run partitioning rounds until the cutoff, each round solving the regions
+ * in parallel for round_time. Return 0 if the best cover is valid
+ */
+int FastWVCPartitioned::Solve()
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int r, v, round;
+
+    rng.Seed(seed);
+    total_steps = 0;
+    best_comp_time = 0.0;
+    if (v_num == 0)
+    {
+        in_cover.clear();
+        best_weight = 0;
+        return 0;
+    }
+    best_weight = in_cover.empty() ? (llong)(~0ULL >> 1) : CoverWeight(in_cover);
+
+    local_weights.resize(num_threads);
+    local_offsets.resize(num_threads);
+    local_indices.resize(num_threads);
+    while ((int)solvers.size() < num_threads)
+    {
+        solvers.push_back(unique_ptr<FastWVC>(new FastWVC()));
+    }
+
+    // By default a round lasts a tenth of the cutoff, but at least ten
+    // times the setup (partitioning and rebuilding the region instances)
+    // of the last round, so that the setup stays a small share of it
+    double setup_time = 0.0;
+    for (round = 0;; round++)
+    {
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (elapsed >= cutoff_time && !in_cover.empty())
+        {
+            break;
+        }
+        double round_limit = round_time > 0 ? round_time : max(cutoff_time / 10, 10 * setup_time);
+        double time_limit = max(0.0, min(round_limit, cutoff_time - elapsed));
+
+        Partition(num_threads);
+        FreezeBoundary();
+
+        members.resize(num_threads);
+        for (r = 0; r < num_threads; r++)
+        {
+            members[r].clear();
+        }
+        local_of.assign(v_num, -1);
+        for (v = 0; v < v_num; v++)
+        {
+            if (frozen[v] == 0)
+            {
+                local_of[v] = (int)members[region[v]].size();
+                members[region[v]].push_back(v);
+            }
+        }
+
+        vector<vector<int>> covers(num_threads);
+        vector<llong> cover_weights(num_threads, 0);
+        vector<llong> steps(num_threads, 0);
+        vector<thread> threads;
+        for (r = 0; r < num_threads; r++)
+        {
+            uint worker_seed = seed + (uint)(round * num_threads + r);
+            threads.push_back(thread([this, r, worker_seed, time_limit, &covers, &cover_weights, &steps]()
+                                     { SolveRegion(r, worker_seed, time_limit, covers[r], cover_weights[r], steps[r]); }));
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        setup_time = max(0.0, chrono::duration<double>(chrono::steady_clock::now() - start).count() - elapsed - time_limit);
+
+        // Frozen vertices cover the boundary, the region covers the rest
+        vector<char> merged(frozen);
+        llong weight = CoverWeight(frozen);
+        for (r = 0; r < num_threads; r++)
+        {
+            for (int u : covers[r])
+            {
+                merged[u] = 1;
+            }
+            weight += cover_weights[r];
+            total_steps += steps[r];
+        }
+
+        if (weight <= best_weight)
+        {
+            if (weight < best_weight)
+            {
+                best_comp_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            }
+            best_weight = weight;
+            in_cover.swap(merged);
+        }
+    }
+
+    return CheckSolution() == 1 ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+#include "mwvc.h"
+
+/*
+ * Regression checks of the checkpoint format (an exact resume in every
+ * CC mode, and the rejection of truncated, corrupt and foreign files) and
+ * of long searches on a small graph, which go through the edge-weight
+ * rescaling when built with -DFASTWVC_EDGE_WEIGHT_16
+ */
+
+static int failures = 0;
+
+static void Check(bool ok, const string &name)
+{
+    cout << (ok ? "ok      " : "FAILED  ") << name << endl;
+    if (!ok)
+    {
+        failures++;
+    }
+}
+
+/*
+ * Random graph in CSR form: v_num vertices, about e_num edges (no
+ * duplicates or loops) and weights in 20..119
+ */
+static void RandomGraph(int v_num, int e_num, uint seed, vector<int> &weights, vector<int> &row_offsets, vector<int> &col_indices)
+{
+    Xoshiro128 rng;
+    vector<vector<int>> neighbors(v_num);
+    int u, x, i;
+
+    rng.Seed(seed);
+    weights.resize(v_num);
+    for (u = 0; u < v_num; u++)
+    {
+        weights[u] = 20 + rng.Bounded(100);
+    }
+    for (i = 0; i < e_num; i++)
+    {
+        u = rng.Bounded(v_num);
+        x = rng.Bounded(v_num);
+        if (u != x && find(neighbors[u].begin(), neighbors[u].end(), x) == neighbors[u].end())
+        {
+            neighbors[u].push_back(x);
+            neighbors[x].push_back(u);
+        }
+    }
+
+    row_offsets.assign(1, 0);
+    col_indices.clear();
+    for (u = 0; u < v_num; u++)
+    {
+        col_indices.insert(col_indices.end(), neighbors[u].begin(), neighbors[u].end());
+        row_offsets.push_back((int)col_indices.size());
+    }
+}
+
+static string ReadFile(const string &filename)
+{
+    ifstream in(filename, ios::binary);
+    return string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+static void WriteFile(const string &filename, const string &data)
+{
+    ofstream out(filename, ios::binary);
+    out.write(data.data(), data.size());
+}
+
+/*
+ * Weight of a minimum weighted vertex cover, by enumeration (small graphs)
+ */
+static llong OptimalWeight(const vector<int> &weights, const vector<int> &row_offsets, const vector<int> &col_indices)
+{
+    int v_num = (int)weights.size();
+    llong best = (llong)(~0ULL >> 1);
+
+    for (uint32_t set = 0; set < (1u << v_num); set++)
+    {
+        bool covered = true;
+        for (int u = 0; u < v_num && covered; u++)
+        {
+            for (int i = row_offsets[u]; i < row_offsets[u + 1] && covered; i++)
+            {
+                covered = ((set >> u) & 1) != 0 || ((set >> col_indices[i]) & 1) != 0;
+            }
+        }
+
+        if (covered)
+        {
+            llong weight = 0;
+            for (int u = 0; u < v_num; u++)
+            {
+                weight += ((set >> u) & 1) != 0 ? weights[u] : 0;
+            }
+            best = min(best, weight);
+        }
+    }
+    return best;
+}
+
+/*
+ * Solve the graph with a step budget only, optionally saving or loading a
+ * checkpoint; return Solve()'s result and the best cover
+ */
+static int SolveSteps(const vector<int> &weights, const vector<int> &row_offsets, const vector<int> &col_indices,
+                      int mode, llong steps, const string &save, const string &load, vector<bool> &cover, int *loaded = 0)
+{
+    FastWVC solver;
+    solver.BuildInstance((int)weights.size(), weights.data(), row_offsets.data(), col_indices.data());
+    solver.seed = 7;
+    solver.cutoff_time = 1000;
+    solver.mode = mode;
+    solver.max_steps = steps;
+    solver.checkpoint_file = save;
+    if (!load.empty())
+    {
+        int result = solver.LoadCheckpoint(load);
+        if (loaded != 0)
+        {
+            *loaded = result;
+        }
+    }
+
+    int result = solver.Solve();
+    solver.GetBestCover(cover);
+    return result;
+}
+
+int main()
+{
+    vector<int> weights, row_offsets, col_indices;
+    vector<int> other_weights, other_row_offsets, other_col_indices;
+    const string file = "fastwvc_tests.ckpt";
+    const string bad_file = "fastwvc_tests_bad.ckpt";
+    int mode, loaded;
+
+    RandomGraph(400, 3000, 1, weights, row_offsets, col_indices);
+    RandomGraph(400, 3000, 2, other_weights, other_row_offsets, other_col_indices);
+
+    // A search checkpointed and resumed ends where an uninterrupted one does
+    for (mode = 0; mode < 4; mode++)
+    {
+        vector<bool> full, resumed;
+        int full_result = SolveSteps(weights, row_offsets, col_indices, mode, 300000, "", "", full);
+        SolveSteps(weights, row_offsets, col_indices, mode, 120000, file, "", resumed);
+        int resumed_result = SolveSteps(weights, row_offsets, col_indices, mode, 300000, "", file, resumed, &loaded);
+        Check(full_result == 0 && resumed_result == 0 && loaded == 0 && full == resumed,
+              "mode " + to_string(mode) + ": resumed search matches the uninterrupted one");
+    }
+
+    // Damaged or foreign checkpoints are rejected and the search starts over
+    vector<bool> cover;
+    SolveSteps(weights, row_offsets, col_indices, 0, 50000, file, "", cover);
+    string data = ReadFile(file);
+    int v_num = (int)weights.size();
+    size_t flags_offset = 8 + 4 * sizeof(int) + sizeof(uint64_t) + 4 * sizeof(llong) + 4 * sizeof(double) +
+                          7 * sizeof(int) + 4 * sizeof(uint32_t);
+    size_t last_cand = data.size() - sizeof(int);
+    int entry;
+
+    vector<pair<string, string>> damaged;
+    damaged.push_back(make_pair("truncated", data.substr(0, data.size() - 3)));
+    damaged.push_back(make_pair("header only", data.substr(0, flags_offset)));
+    damaged.push_back(make_pair("trailing byte", data + '\0'));
+
+    string corrupt = data;
+    entry = v_num + 1;
+    memcpy(&corrupt[last_cand], &entry, sizeof(int));
+    damaged.push_back(make_pair("remove_cand entry out of range", corrupt));
+
+    corrupt = data;
+    memcpy(&corrupt[last_cand], &corrupt[last_cand - sizeof(int)], sizeof(int));
+    damaged.push_back(make_pair("duplicate remove_cand entry", corrupt));
+
+    corrupt = data;
+    corrupt[flags_offset + 1] = 2;
+    damaged.push_back(make_pair("cover flag of 2", corrupt));
+
+    corrupt = data;
+    corrupt[0] = 'X';
+    damaged.push_back(make_pair("wrong magic", corrupt));
+
+    for (auto &name_and_data : damaged)
+    {
+        WriteFile(bad_file, name_and_data.second);
+        int result = SolveSteps(weights, row_offsets, col_indices, 0, 20000, "", bad_file, cover, &loaded);
+        Check(loaded == 1 && result == 0, "rejects a checkpoint with " + name_and_data.first);
+    }
+
+    int result = SolveSteps(other_weights, other_row_offsets, other_col_indices, 0, 20000, "", file, cover, &loaded);
+    Check(loaded == 1 && result == 0, "rejects a checkpoint of another instance");
+
+    result = SolveSteps(weights, row_offsets, col_indices, 0, 20000, "", "fastwvc_tests_missing.ckpt", cover, &loaded);
+    Check(loaded == 1 && result == 0, "rejects a missing checkpoint");
+
+    remove(file.c_str());
+    remove(bad_file.c_str());
+
+    // Edge weights saturate quickly on a small graph, so 16-bit builds
+    // rescale them many times in each mode; the optimum must still be found
+    RandomGraph(20, 40, 3, weights, row_offsets, col_indices);
+    llong optimum = OptimalWeight(weights, row_offsets, col_indices);
+    for (mode = 0; mode < 4; mode++)
+    {
+        result = SolveSteps(weights, row_offsets, col_indices, mode, 500000, "", "", cover);
+        llong weight = 0;
+        for (int u = 0; u < (int)weights.size(); u++)
+        {
+            weight += cover[u] ? weights[u] : 0;
+        }
+        Check(result == 0 && weight == optimum, "mode " + to_string(mode) + ": long search on a small graph finds the optimum");
+    }
+
+    cout << (failures == 0 ? "All checks passed." : to_string(failures) + " check(s) failed.") << endl;
+    return failures == 0 ? 0 : 1;
+}
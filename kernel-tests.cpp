@@ -0,0 +1,205 @@
+#include <random>
+#include <sstream>
+#include <unistd.h>
+#include "auction-solver.h"
+
+/*
+ * Regression checks of the reductions and kernel files on the sample
+ * auctions and on small random ones: the simplicial reduction keeps the
+ * optimal value, an exported kernel solved by FastWVC lifts back to an
+ * optimal auction, and a kernel cache entry restores the same kernel.
+ * Run from the repository root, where it writes its scratch files (and
+ * auction_results.txt):
+ *   g++ -std=c++11 -m64 kernel-tests.cpp -o kernel-tests -Iinclude/ -Llib -lgurobi_c++ -lgurobi95 -lm -pthread
+ *   ./kernel-tests
+ */
+
+int failures = 0;
+
+void check(bool ok, std::string name) {
+    std::cout << (ok ? "ok      " : "FAILED  ") << name << std::endl;
+    if (!ok) {
+        failures++;
+    }
+}
+
+/*
+ * Write a random auction in the format of readAuctionMwvc
+ */
+void writeRandomAuction(std::string auctionFileName, int goods, int numAuctionBids, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::ofstream outfile(auctionFileName);
+
+    outfile << goods << " " << numAuctionBids << std::endl;
+    for (int i = 0; i < numAuctionBids; i++) {
+        int size = 1 + rng() % 3;
+        std::vector<int> bidGoods;
+        while ((int)bidGoods.size() < size) {
+            int good = 1 + rng() % goods;
+            if (std::find(bidGoods.begin(), bidGoods.end(), good) == bidGoods.end()) {
+                bidGoods.push_back(good);
+            }
+        }
+
+        outfile << 10 + rng() % 90 << " ";
+        for (int j = 0; j < size; j++) {
+            outfile << (j > 0 ? "," : "") << bidGoods[j];
+        }
+        outfile << std::endl;
+    }
+}
+
+/*
+ * Value of an optimal auction over the remaining bids, by enumeration,
+ * plus the bids fixed to win by the reductions
+ */
+long long bruteForceAuctionValue() {
+    long long best = 0;
+
+    for (unsigned set = 0; set < (1u << numBids); set++) {
+        long long value = 0;
+        bool feasible = true;
+        for (int i = 0; i < numBids && feasible; i++) {
+            if (((set >> i) & 1) == 0) {
+                continue;
+            }
+            value += bids[i].value;
+            for (int j = 0; j < i && feasible; j++) {
+                feasible = ((set >> j) & 1) == 0 || !intersects(bids[i], bids[j]);
+            }
+        }
+
+        if (feasible) {
+            best = std::max(best, value);
+        }
+    }
+
+    return best + excludedBidsValues;
+}
+
+/*
+ * Read the auction value written to the auction results file
+ */
+long long resultsValue() {
+    std::ifstream infile("auction_results.txt");
+    long long value = -1;
+    infile >> value;
+    return value;
+}
+
+/*
+ * Lift the given kernel solution file contents back into the auction
+ */
+int liftText(std::string auctionFileName, std::string kernelPrefix, std::string solution) {
+    std::ofstream(kernelPrefix + ".sol") << solution;
+    resetState();
+    readAuctionMwvc(auctionFileName);
+    return liftKernelSolution(kernelPrefix, kernelPrefix + ".sol");
+}
+
+void testAuction(std::string auctionFileName) {
+    const std::string kernelPrefix = "kernel_tests_kernel";
+    const std::string cacheDir = "kernel_tests_cache";
+
+    // Optimum of the unreduced auction
+    resetState();
+    readAuctionMwvc(auctionFileName);
+    long long optimum = bruteForceAuctionValue();
+
+    // The simplicial reduction keeps it
+    resetState();
+    readAuctionMwvc(auctionFileName);
+    simplicialReduce();
+    check(bruteForceAuctionValue() == optimum, auctionFileName + ": simplicial reduction keeps the optimum");
+
+    // Export the kernel, and store it in the cache with a dual per edge
+    buildConflictGraph();
+    for (Edge& edge : edges) {
+        kernelEdgeDuals[originalEdgeKey(bids[edge.v1 - 1], bids[edge.v2 - 1])] = 0.25 + 0.5 / edge.v2;
+    }
+    std::string cacheKey = auctionContentHash();
+    check(writeKernelInstance(kernelPrefix) == 0 && storeKernelCache(cacheDir, cacheKey) == 0,
+          auctionFileName + ": kernel exported and cached");
+    int kernelBids = numBids;
+    size_t kernelEdges = edges.size();
+    std::unordered_map<long long, double> kernelDuals = kernelEdgeDuals;
+
+    // The cache entry restores the same kernel and duals
+    resetState();
+    readAuctionMwvc(auctionFileName);
+    check(loadKernelCache(cacheDir, cacheKey) == 0 && numBids == kernelBids &&
+          edges.size() == kernelEdges && kernelEdgeDuals == kernelDuals,
+          auctionFileName + ": kernel cache round trip");
+
+    // Solve the kernel as the mwvc command would and lift its output
+    FastWVC solver;
+    solver.BuildInstance(kernelPrefix + ".mwvc");
+    solver.max_steps = 20000;
+    solver.cutoff_time = 1000;
+    solver.Solve();
+
+    std::vector<bool> cover;
+    solver.GetBestCover(cover);
+    std::ostringstream solution;
+    solution << kernelPrefix << ".mwvc, " << solver.BestWeight() << ", 0.01" << std::endl;
+    std::string delim = "";
+    for (int i = 0; i < solver.VertexCount(); i++) {
+        if (cover[i]) {
+            solution << delim << i + 1;
+            delim = ",";
+        }
+    }
+    solution << std::endl;
+
+    check(liftText(auctionFileName, kernelPrefix, "12, 0.5, 3\n" + solution.str()) == 0 &&
+          resultsValue() == optimum, auctionFileName + ": lifted kernel solution is optimal");
+
+    // Output without a cover line is rejected, but a kernel without bids
+    // needs none
+    check(liftText(auctionFileName, kernelPrefix, "12, 0.5, 3\n") != 0,
+          auctionFileName + ": progress lines alone are not a cover");
+    if (kernelBids == 0) {
+        check(liftText(auctionFileName, kernelPrefix, "") == 0 && resultsValue() == optimum,
+              auctionFileName + ": an empty solution lifts an empty kernel");
+    }
+
+    std::remove((kernelPrefix + ".mwvc").c_str());
+    std::remove((kernelPrefix + ".bin").c_str());
+    std::remove((kernelPrefix + ".lift").c_str());
+    std::remove((kernelPrefix + ".sol").c_str());
+    std::remove((cacheDir + "/" + cacheKey + ".kernel").c_str());
+    rmdir(cacheDir.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> auctionFileNames = {"auction1.txt", "auction2.txt", "auction3.txt"};
+    for (int seed = 0; seed < 20; seed++) {
+        std::string auctionFileName = "kernel_tests_auction" + std::to_string(seed) + ".txt";
+        writeRandomAuction(auctionFileName, 12, 16, seed);
+        auctionFileNames.push_back(auctionFileName);
+    }
+
+    for (std::string& auctionFileName : auctionFileNames) {
+        testAuction(auctionFileName);
+    }
+
+    // A cover line may look like a progress line
+    resetState();
+    readAuctionMwvc("auction1.txt");
+    buildConflictGraph();
+    writeKernelInstance("kernel_tests_kernel");
+    check(liftText("auction1.txt", "kernel_tests_kernel", "1, 4\n") == 0 && resultsValue() == 250,
+          "auction1.txt: a lone \"1, 4\" cover line lifts");
+    check(liftText("auction1.txt", "kernel_tests_kernel", "kernel_tests_kernel.mwvc, 226, 0.1\n1,4\n") != 0,
+          "auction1.txt: a cover not matching the summary weight is rejected");
+
+    for (std::string suffix : {".mwvc", ".bin", ".lift", ".sol"}) {
+        std::remove(("kernel_tests_kernel" + suffix).c_str());
+    }
+    for (int seed = 0; seed < 20; seed++) {
+        std::remove(auctionFileNames[3 + seed].c_str());
+    }
+
+    std::cout << (failures == 0 ? "All checks passed." : std::to_string(failures) + " check(s) failed.") << std::endl;
+    return failures == 0 ? 0 : 1;
+}